@@ -1,15 +1,5 @@
 #include <Adafruit_LPS2X.h>
-
-/**
- * @brief Destroy the Adafruit_LPS22::Adafruit_LPS22 object
- *
- */
-Adafruit_LPS22::~Adafruit_LPS22(void) {
-  if (temp_sensor)
-    delete temp_sensor;
-  if (pressure_sensor)
-    delete pressure_sensor;
-}
+#include <Adafruit_LPS2X_Decode.h>
 
 /*!  @brief Initializer for post i2c/spi init
  *   @param sensor_id Optional unique ID for the sensor set
@@ -17,55 +7,56 @@ Adafruit_LPS22::~Adafruit_LPS22(void) {
  */
 bool Adafruit_LPS22::_init(int32_t sensor_id) {
 
-  Adafruit_BusIO_Register chip_id = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS2X_WHOAMI, 1);
-
   // make sure we're talking to the right chip
-  uint8_t id = chip_id.read();
-
-  if (id != LPS22HB_CHIP_ID) {
+  uint8_t id;
+  if (!_readRegister(LPS2X_WHOAMI, &id) || id != LPS22HB_CHIP_ID) {
     return false;
   }
   _sensorid_pressure = sensor_id;
   _sensorid_temp = sensor_id + 1;
 
-  temp_scaling = 100;
-  temp_offset = 0;
-
-  ctrl1_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS22_CTRL_REG1, 1);
-  ctrl2_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS22_CTRL_REG2, 1);
-  ctrl3_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS22_CTRL_REG3, 1);
-  threshp_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS22_THS_P_L_REG, 1);
-
-  reset();
+  temp_scaling = LPS22_TEMP_LSB_PER_C;
+  temp_offset = LPS22_TEMP_OFFSET;
+  temp_scaling_fixed = 6553600 / LPS22_TEMP_LSB_PER_C;
+  temp_offset_fixed = (int16_t)(LPS22_TEMP_OFFSET * 100);
+  pres_ready_flag = 0x01;
+
+  ctrl1_reg.address = LPS22_CTRL_REG1;
+  ctrl2_reg.address = LPS22_CTRL_REG2;
+  ctrl3_reg.address = LPS22_CTRL_REG3;
+  fifo_ctrl_reg.address = LPS22_FIFO_CTRL;
+  res_conf_reg.address = LPS22_RES_CONF;
+  int_cfg_reg.address = LPS22_INTERRUPT_CFG;
+  threshp_reg = LPS22_THS_P_L_REG;
+  refp_reg = LPS22_REF_P_XL;
+  rpds_reg = LPS22_RPDS_L;
+
+  if (!_prepareRegisters()) {
+    return false;
+  }
   // do any software reset or other initial setup
   setDataRate(LPS22_RATE_25_HZ);
   // interrupt on data ready
   configureInterrupt(true, false, true);
 
-  pressure_sensor = new Adafruit_LPS2X_Pressure(this);
-  temp_sensor = new Adafruit_LPS2X_Temp(this);
-
-  delay(10); // delay for first reading
+  _waitForFirstSample();
   return true;
 }
 
+/** Output data period in microseconds for each `lps22_rate_t` */
+static const uint32_t lps22_periods[] = {0, 1000000, 100000,
+                                         40000, 20000, 13333};
+
 /**
  * @brief Sets the rate at which pressure and temperature measurements
  *
  * @param new_data_rate The data rate to set. Must be a `lps22_rate_t`
  */
 void Adafruit_LPS22::setDataRate(lps22_rate_t new_data_rate) {
-  Adafruit_BusIO_RegisterBits data_rate =
-      Adafruit_BusIO_RegisterBits(ctrl1_reg, 3, 4);
-
-  data_rate.write((uint8_t)new_data_rate);
+  _writeBits(&ctrl1_reg, 3, 4, (uint8_t)new_data_rate);
 
   isOneShot = (new_data_rate == LPS22_RATE_ONE_SHOT) ? true : false;
+  samplePeriod = lps22_periods[new_data_rate];
 }
 
 /**
@@ -75,10 +66,7 @@ void Adafruit_LPS22::setDataRate(lps22_rate_t new_data_rate) {
  * @return lps22_rate_t The current data rate
  */
 lps22_rate_t Adafruit_LPS22::getDataRate(void) {
-  Adafruit_BusIO_RegisterBits data_rate =
-      Adafruit_BusIO_RegisterBits(ctrl1_reg, 3, 4);
-
-  return (lps22_rate_t)data_rate.read();
+  return (lps22_rate_t)_readBits(&ctrl1_reg, 3, 4);
 }
 
 /**
@@ -100,5 +88,114 @@ void Adafruit_LPS22::configureInterrupt(bool activelow, bool opendrain,
   uint8_t reg = (activelow << 7) | (opendrain << 6) | (fifo_full << 5) |
                 (fifo_watermark << 4) | (fifo_overflow << 3) |
                 (data_ready << 2) | (pres_low << 1) | (pres_high);
-  ctrl3_reg->write(reg);
+  _writeBits(&ctrl3_reg, 8, 0, reg);
+}
+
+/**
+ * @brief Sets the FIFO operating mode. Any mode other than bypass also
+ * enables the FIFO in CTRL_REG2
+ *
+ * @param mode The FIFO mode to set. Must be a `lps22_fifo_mode_t`
+ */
+void Adafruit_LPS22::setFifoMode(lps22_fifo_mode_t mode) {
+  _writeBits(&ctrl2_reg, 1, 6, mode != LPS22_FIFO_BYPASS);
+  _writeBits(&fifo_ctrl_reg, 3, 5, (uint8_t)mode);
+}
+
+/**
+ * @brief Gets the current FIFO operating mode
+ *
+ * @return lps22_fifo_mode_t The current FIFO mode
+ */
+lps22_fifo_mode_t Adafruit_LPS22::getFifoMode(void) {
+  return (lps22_fifo_mode_t)_readBits(&fifo_ctrl_reg, 3, 5);
+}
+
+/**
+ * @brief Sets the FIFO watermark level used for the `fifo_watermark`
+ * interrupt
+ *
+ * @param level The number of samples at which the watermark triggers, 0-31
+ * @param stop_on_watermark If true, the FIFO depth is limited to the
+ * watermark level
+ */
+void Adafruit_LPS22::setFifoWatermark(uint8_t level, bool stop_on_watermark) {
+  _writeBits(&fifo_ctrl_reg, 5, 0, level);
+  _writeBits(&ctrl2_reg, 1, 5, stop_on_watermark);
+}
+
+/**
+ * @brief Reads the number of unread samples in the FIFO
+ *
+ * @param level Where to store the number of samples waiting, 0-32
+ * @return True if FIFO_STATUS was read
+ */
+bool Adafruit_LPS22::_readFifoLevel(uint8_t *level) {
+  uint8_t status;
+  if (!_readRegister(LPS22_FIFO_STATUS, &status)) {
+    return false;
+  }
+  *level = status & 0x3F;
+  return true;
+}
+
+/**
+ * @brief Enables low-current mode, which lowers the supply current at the
+ * cost of more noise. The mode can only be changed while powered down, so
+ * the data rate is briefly set to one-shot to make the change
+ *
+ * @param low_current True to enable low-current mode
+ */
+void Adafruit_LPS22::setLowCurrent(bool low_current) {
+  lps22_rate_t rate = getDataRate();
+
+  setDataRate(LPS22_RATE_ONE_SHOT);
+  _writeBits(&res_conf_reg, 1, 0, low_current);
+  setDataRate(rate);
+}
+
+/**
+ * @brief Switches to one-shot mode for duty cycled sampling. The LPS22 is
+ * powered down between one-shot conversions, so nothing else is needed
+ */
+void Adafruit_LPS22::_setupDutyCycle(void) {
+  setDataRate(LPS22_RATE_ONE_SHOT);
+}
+
+/**
+ * @brief Selects the reference threshold events are measured against.
+ * Autozero and AUTORIFP capture the current pressure into REF_P on the next
+ * conversion; calling again recaptures it. With autozero the pressure outputs
+ * also become relative to REF_P, while AUTORIFP only affects thresholds.
+ * Switching back to `LPS2X_REFERENCE_FIXED` clears REF_P to 0
+ *
+ * @param mode The reference mode. Must be a `lps2x_reference_mode_t`
+ * @return true: the mode was set
+ */
+bool Adafruit_LPS22::setReferenceMode(lps2x_reference_mode_t mode) {
+  // AUTORIFP (b7) and AUTOZERO (b5) with their self-clearing resets, RESET_ARP
+  // (b6) and RESET_AZ (b4), which also zero REF_P
+  uint8_t cfg = int_cfg_reg.value & 0x0F;
+  if ((mode != LPS2X_REFERENCE_FIXED) || (int_cfg_reg.value & 0xA0)) {
+    _writeRegister(int_cfg_reg.address, cfg | 0x50);
+  }
+  if (mode == LPS2X_REFERENCE_AUTOZERO) {
+    cfg |= 0x20;
+  } else if (mode == LPS2X_REFERENCE_AUTORIFP) {
+    cfg |= 0x80;
+  }
+  if (cfg != (int_cfg_reg.value & 0x0F)) {
+    _writeRegister(int_cfg_reg.address, cfg);
+  }
+  int_cfg_reg.value = cfg;
+  return true;
+}
+
+/**
+ * @brief Enables threshold interrupt generation, DIFF_EN in INTERRUPT_CFG
+ *
+ * @param enable True to enable
+ */
+void Adafruit_LPS22::_setThresholdEnable(bool enable) {
+  _writeBits(&int_cfg_reg, 1, 3, enable);
 }
@@ -1,15 +1,5 @@
 #include <Adafruit_LPS2X.h>
-
-/**
- * @brief Destroy the Adafruit_LPS25::Adafruit_LPS25 object
- *
- */
-Adafruit_LPS25::~Adafruit_LPS25(void) {
-  if (temp_sensor)
-    delete temp_sensor;
-  if (pressure_sensor)
-    delete pressure_sensor;
-}
+#include <Adafruit_LPS2X_Decode.h>
 
 /*!  @brief Initializer for post i2c/spi init
  *   @param sensor_id Optional unique ID for the sensor set
@@ -17,56 +7,56 @@ Adafruit_LPS25::~Adafruit_LPS25(void) {
  */
 bool Adafruit_LPS25::_init(int32_t sensor_id) {
 
-  Adafruit_BusIO_Register chip_id = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS2X_WHOAMI, 1);
-
   // make sure we're talking to the right chip
-  uint8_t id = chip_id.read();
-
-  if (id != LPS25HB_CHIP_ID) {
+  uint8_t id;
+  if (!_readRegister(LPS2X_WHOAMI, &id) || id != LPS25HB_CHIP_ID) {
     return false;
   }
   _sensorid_pressure = sensor_id;
   _sensorid_temp = sensor_id + 1;
 
-  temp_scaling = 480;
-  temp_offset = 42.5;
+  temp_scaling = LPS25_TEMP_LSB_PER_C;
+  temp_offset = LPS25_TEMP_OFFSET;
+  temp_scaling_fixed = 6553600 / LPS25_TEMP_LSB_PER_C;
+  temp_offset_fixed = (int16_t)(LPS25_TEMP_OFFSET * 100);
   inc_spi_flag = 0x40;
+  pres_ready_flag = 0x02;
 
-  ctrl1_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_CTRL_REG1, 1);
-  ctrl2_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_CTRL_REG2, 1);
-  ctrl3_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_CTRL_REG3, 1);
-  threshp_reg = new Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_THS_P_L_REG, 1);
+  ctrl1_reg.address = LPS25_CTRL_REG1;
+  ctrl2_reg.address = LPS25_CTRL_REG2;
+  ctrl3_reg.address = LPS25_CTRL_REG3;
+  ctrl4_reg.address = LPS25_CTRL_REG4;
+  fifo_ctrl_reg.address = LPS25_FIFO_CTRL;
+  res_conf_reg.address = LPS25_RES_CONF;
+  int_cfg_reg.address = LPS25_INTERRUPT_CFG;
+  threshp_reg = LPS25_THS_P_L_REG;
+  refp_reg = LPS25_REF_P_XL;
+  rpds_reg = LPS25_RPDS_L;
 
-  reset();
+  if (!_prepareRegisters()) {
+    return false;
+  }
   // do any software reset or other initial setup
   powerDown(false);
   setDataRate(LPS25_RATE_25_HZ);
 
-  pressure_sensor = new Adafruit_LPS2X_Pressure(this);
-  temp_sensor = new Adafruit_LPS2X_Temp(this);
-  delay(10); // delay for first reading
+  _waitForFirstSample();
   return true;
 }
 
+/** Output data period in microseconds for each `lps25_rate_t` */
+static const uint32_t lps25_periods[] = {0, 1000000, 142857, 80000, 40000};
+
 /**
  * @brief Sets the rate at which pressure and temperature measurements
  *
  * @param new_data_rate The data rate to set. Must be a `lps25_rate_t`
  */
 void Adafruit_LPS25::setDataRate(lps25_rate_t new_data_rate) {
-  Adafruit_BusIO_Register ctrl1 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_CTRL_REG1, 1);
-  Adafruit_BusIO_RegisterBits data_rate =
-      Adafruit_BusIO_RegisterBits(&ctrl1, 3, 4);
-
-  data_rate.write((uint8_t)new_data_rate);
+  _writeBits(&ctrl1_reg, 3, 4, (uint8_t)new_data_rate);
 
   isOneShot = (new_data_rate == LPS25_RATE_ONE_SHOT) ? true : false;
+  samplePeriod = lps25_periods[new_data_rate];
 }
 
 /**
@@ -76,12 +66,7 @@ void Adafruit_LPS25::setDataRate(lps25_rate_t new_data_rate) {
  * @return lps25_rate_t The current data rate
  */
 lps25_rate_t Adafruit_LPS25::getDataRate(void) {
-  Adafruit_BusIO_Register ctrl1 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, LPS25_CTRL_REG1, 1);
-  Adafruit_BusIO_RegisterBits data_rate =
-      Adafruit_BusIO_RegisterBits(&ctrl1, 3, 4);
-
-  return (lps25_rate_t)data_rate.read();
+  return (lps25_rate_t)_readBits(&ctrl1_reg, 3, 4);
 }
 
 /**
@@ -90,8 +75,24 @@ lps25_rate_t Adafruit_LPS25::getDataRate(void) {
  * @param power_down
  */
 void Adafruit_LPS25::powerDown(bool power_down) {
-  Adafruit_BusIO_RegisterBits pd = Adafruit_BusIO_RegisterBits(ctrl1_reg, 1, 7);
-  pd.write(!power_down); // pd bit->0 == power down
+  _writeBits(&ctrl1_reg, 1, 7, !power_down); // pd bit->0 == power down
+}
+
+/**
+ * @brief Switches to one-shot mode for duty cycled sampling
+ */
+void Adafruit_LPS25::_setupDutyCycle(void) {
+  setDataRate(LPS25_RATE_ONE_SHOT);
+}
+
+/**
+ * @brief Powers the sensor up for or down after a duty cycled sample
+ *
+ * @param active True to wake the sensor, false to power it down
+ * @return true: the write succeeded
+ */
+bool Adafruit_LPS25::_setDutyCyclePower(bool active) {
+  return _writeBits(&ctrl1_reg, 1, 7, active); // pd bit->0 == power down
 }
 
 /**
@@ -105,5 +106,168 @@ void Adafruit_LPS25::configureInterrupt(bool activelow, bool opendrain,
                                         bool pres_high, bool pres_low) {
   uint8_t reg =
       (activelow << 7) | (opendrain << 6) | (pres_low << 1) | pres_high;
-  ctrl3_reg->write(reg);
+  _writeBits(&ctrl3_reg, 8, 0, reg);
+}
+
+/**
+ * @brief Selects which events drive the INT pin when `configureInterrupt` is
+ * set to output the data signal (the default)
+ * @param data_ready If true, interrupt fires on new data ready
+ * @param fifo_overrun If true, interrupt fires on FIFO overrun
+ * @param fifo_watermark If true, interrupt fires on FIFO watermark pass
+ * @param fifo_empty If true, interrupt fires when the FIFO is empty
+ */
+void Adafruit_LPS25::configureDataInterrupt(bool data_ready, bool fifo_overrun,
+                                            bool fifo_watermark,
+                                            bool fifo_empty) {
+  uint8_t reg = (fifo_empty << 3) | (fifo_watermark << 2) |
+                (fifo_overrun << 1) | data_ready;
+  _writeBits(&ctrl4_reg, 8, 0, reg);
+}
+
+/**
+ * @brief Sets the number of internal pressure samples averaged into each
+ * output sample. More averaging lowers noise at the cost of supply current
+ *
+ * @param samples The number of samples to average. Must be a
+ * `lps25_pres_avg_t`
+ */
+void Adafruit_LPS25::setPressureAveraging(lps25_pres_avg_t samples) {
+  _writeBits(&res_conf_reg, 2, 0, (uint8_t)samples);
+}
+
+/**
+ * @brief Gets the number of internal pressure samples averaged into each
+ * output sample
+ *
+ * @return lps25_pres_avg_t The current pressure averaging
+ */
+lps25_pres_avg_t Adafruit_LPS25::getPressureAveraging(void) {
+  return (lps25_pres_avg_t)_readBits(&res_conf_reg, 2, 0);
+}
+
+/**
+ * @brief Sets the number of internal temperature samples averaged into each
+ * output sample
+ *
+ * @param samples The number of samples to average. Must be a
+ * `lps25_temp_avg_t`
+ */
+void Adafruit_LPS25::setTemperatureAveraging(lps25_temp_avg_t samples) {
+  _writeBits(&res_conf_reg, 2, 2, (uint8_t)samples);
+}
+
+/**
+ * @brief Gets the number of internal temperature samples averaged into each
+ * output sample
+ *
+ * @return lps25_temp_avg_t The current temperature averaging
+ */
+lps25_temp_avg_t Adafruit_LPS25::getTemperatureAveraging(void) {
+  return (lps25_temp_avg_t)_readBits(&res_conf_reg, 2, 2);
+}
+
+/**
+ * @brief Sets the FIFO operating mode. Any mode other than bypass also
+ * enables the FIFO in CTRL_REG2. In `LPS25_FIFO_MEAN` mode the output
+ * registers hold a running average of the number of samples set with
+ * `setFifoMeanSamples`
+ *
+ * @param mode The FIFO mode to set. Must be a `lps25_fifo_mode_t`
+ */
+void Adafruit_LPS25::setFifoMode(lps25_fifo_mode_t mode) {
+  _writeBits(&ctrl2_reg, 1, 6, mode != LPS25_FIFO_BYPASS);
+  _writeBits(&fifo_ctrl_reg, 3, 5, (uint8_t)mode);
+}
+
+/**
+ * @brief Gets the current FIFO operating mode
+ *
+ * @return lps25_fifo_mode_t The current FIFO mode
+ */
+lps25_fifo_mode_t Adafruit_LPS25::getFifoMode(void) {
+  return (lps25_fifo_mode_t)_readBits(&fifo_ctrl_reg, 3, 5);
+}
+
+/**
+ * @brief Sets the FIFO watermark level used for the `fifo_watermark`
+ * interrupt
+ *
+ * @param level The number of samples at which the watermark triggers, 0-31
+ * @param stop_on_watermark If true, the FIFO depth is limited to the
+ * watermark level
+ */
+void Adafruit_LPS25::setFifoWatermark(uint8_t level, bool stop_on_watermark) {
+  _writeBits(&fifo_ctrl_reg, 5, 0, level);
+  _writeBits(&ctrl2_reg, 1, 5, stop_on_watermark);
+}
+
+/**
+ * @brief Sets how many samples are averaged in `LPS25_FIFO_MEAN` mode. This
+ * shares the watermark field of FIFO_CTRL
+ *
+ * @param samples The number of samples to average. Must be a
+ * `lps25_fifo_mean_t`
+ */
+void Adafruit_LPS25::setFifoMeanSamples(lps25_fifo_mean_t samples) {
+  _writeBits(&fifo_ctrl_reg, 5, 0, (uint8_t)samples);
+}
+
+/**
+ * @brief Reads the number of unread samples in the FIFO
+ *
+ * @param level Where to store the number of samples waiting, 0-32
+ * @return True if FIFO_STATUS was read
+ */
+bool Adafruit_LPS25::_readFifoLevel(uint8_t *level) {
+  uint8_t status;
+  if (!_readRegister(LPS25_FIFO_STATUS, &status)) {
+    return false;
+  }
+  if (status & 0x20) { // EMPTY_FIFO
+    *level = 0;
+  } else if (status & 0x40) { // OVR, every slot holds an unread sample
+    *level = LPS2X_FIFO_DEPTH;
+  } else {
+    *level = status & 0x1F;
+  }
+  return true;
+}
+
+/**
+ * @brief Selects the reference threshold events are measured against.
+ * Autozero captures the current pressure into REF_P on the next conversion
+ * and makes the pressure outputs relative to it; calling again recaptures it.
+ * Switching back to `LPS2X_REFERENCE_FIXED` clears REF_P to 0
+ *
+ * @param mode The reference mode. Must be a `lps2x_reference_mode_t`
+ * @return true: the mode was set, false: `LPS2X_REFERENCE_AUTORIFP` is not
+ * supported by the LPS25
+ */
+bool Adafruit_LPS25::setReferenceMode(lps2x_reference_mode_t mode) {
+  if (mode == LPS2X_REFERENCE_AUTORIFP) {
+    return false;
+  }
+  bool autozero = (mode == LPS2X_REFERENCE_AUTOZERO);
+
+  if (autozero || _readBits(&ctrl2_reg, 1, 1)) {
+    // RESET_AZ self-clears, so it is never kept in the shadow copy
+    _writeRegister(ctrl1_reg.address, ctrl1_reg.value | 0x02);
+  }
+  // written even if unchanged, as setting AUTO_ZERO again recaptures REF_P
+  uint8_t ctrl2 = (ctrl2_reg.value & ~0x02) | (autozero << 1);
+  if (!_writeRegister(ctrl2_reg.address, ctrl2)) {
+    return false;
+  }
+  ctrl2_reg.value = ctrl2;
+  return true;
+}
+
+/**
+ * @brief Enables threshold interrupt generation, DIFF_EN in CTRL_REG1
+ *
+ * @param enable True to enable
+ */
+void Adafruit_LPS25::_setThresholdEnable(bool enable) {
+  _writeBits(&ctrl1_reg, 1, 3, enable);
 }
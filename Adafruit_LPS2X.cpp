@@ -34,177 +34,1548 @@
  *     v1.0 - First release
  */
 
-#include "Arduino.h"
-#include <Wire.h>
+#include "Adafruit_LPS2X.h"
+
+#ifndef ARDUINO
+#include "Adafruit_LPS2X_HostClock.h"
+#endif
+
+/**
+ * @brief Construct a new Adafruit_LPS2X::Adafruit_LPS2X object
+ *
+ */
+Adafruit_LPS2X::Adafruit_LPS2X(void)
+    : temp_sensor(this), pressure_sensor(this) {}
+
+/**
+ * @brief Destroy the Adafruit_LPS2X::Adafruit_LPS2X object
+ *
+ */
+Adafruit_LPS2X::~Adafruit_LPS2X(void) { _deleteBusDevices(); }
+
+#ifdef LPS2X_HAS_BUSIO
+
+/*!
+ *    @brief  Sets up the hardware and initializes I2C
+ *    @param  i2c_address
+ *            The I2C address to be used.
+ *    @param  wire
+ *            The Wire object to be used for I2C connections.
+ *    @param  sensor_id
+ *            The unique ID to differentiate the sensors from others
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_LPS2X::begin_I2C(uint8_t i2c_address, TwoWire *wire,
+                               int32_t sensor_id) {
+  _deleteBusDevices(); // remove old interface
+
+  i2c_dev = new Adafruit_I2CDevice(i2c_address, wire);
+
+  if (!i2c_dev->begin()) {
+    return false;
+  }
+
+  return _init(sensor_id);
+}
+
+/*!
+ *    @brief  Sets up the hardware and initializes hardware SPI
+ *    @param  cs_pin The arduino pin # connected to chip select
+ *    @param  theSPI The SPI object to be used for SPI connections.
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @param  frequency The SPI clock in Hz. Defaults to the fastest clock
+ *            the sensors support
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_LPS2X::begin_SPI(uint8_t cs_pin, SPIClass *theSPI,
+                               int32_t sensor_id, uint32_t frequency) {
+  _deleteBusDevices(); // remove old interface
+
+  spi_dev = new Adafruit_SPIDevice(cs_pin,
+                                   frequency,             // frequency
+                                   SPI_BITORDER_MSBFIRST, // bit order
+                                   SPI_MODE0,             // data mode
+                                   theSPI);
+  if (!spi_dev->begin()) {
+    return false;
+  }
+
+  return _init(sensor_id);
+}
+
+/*!
+ *    @brief  Sets up the hardware and initializes software SPI
+ *    @param  cs_pin The arduino pin # connected to chip select
+ *    @param  sck_pin The arduino pin # connected to SPI clock
+ *    @param  miso_pin The arduino pin # connected to SPI MISO
+ *    @param  mosi_pin The arduino pin # connected to SPI MOSI
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @param  frequency The maximum SPI clock in Hz
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_LPS2X::begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
+                               int8_t mosi_pin, int32_t sensor_id,
+                               uint32_t frequency) {
+  _deleteBusDevices(); // remove old interface
+
+  spi_dev = new Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin,
+                                   frequency,             // frequency
+                                   SPI_BITORDER_MSBFIRST, // bit order
+                                   SPI_MODE0);            // data mode
+  if (!spi_dev->begin()) {
+    return false;
+  }
+  return _init(sensor_id);
+}
+#endif
+
+/*!
+ *    @brief  Sets up the hardware on a caller-supplied bus interface, for
+ *            platforms without BusIO
+ *    @param  transport The bus interface. It is not freed by the driver and
+ *            must outlive it
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_LPS2X::begin_Transport(Adafruit_LPS2X_Transport *transport,
+                                     int32_t sensor_id) {
+  _deleteBusDevices(); // remove old interface
+
+  this->transport = transport;
+  if (!transport->begin()) {
+    return false;
+  }
+  return _init(sensor_id);
+}
+
+/*!
+ *    @brief  Frees the bus interface from a previous `begin_*` call
+ */
+void Adafruit_LPS2X::_deleteBusDevices(void) {
+#ifdef LPS2X_HAS_BUSIO
+  if (i2c_dev) {
+    delete i2c_dev;
+    i2c_dev = NULL;
+  }
+  if (spi_dev) {
+    delete spi_dev;
+    spi_dev = NULL;
+  }
+#endif
+  transport = NULL;
+}
+
+/**
+ * @brief Performs a software reset initializing registers to their power on
+ * state
+ * @returns True if the reset completed, false on a bus error or if the chip
+ * did not come out of reset within `LPS2X_TIMEOUT_MS`
+ */
+bool Adafruit_LPS2X::reset(void) {
+  // SWRESET self-clears, so it is never kept in the shadow copy
+  if (!_writeRegister(ctrl2_reg.address, ctrl2_reg.value | 0x04)) {
+    return false;
+  }
+
+  uint32_t start = millis();
+  uint8_t ctrl2;
+  while (true) {
+    if (!_readRegisters(ctrl2_reg.address, &ctrl2, 1)) {
+      return false;
+    }
+    if (!(ctrl2 & 0x04)) {
+      break;
+    }
+    if ((millis() - start) >= LPS2X_TIMEOUT_MS) {
+      bus_stats.timeouts++;
+      return false;
+    }
+    delay(1);
+  }
+  return _loadShadowRegisters();
+}
+
+/**
+ * @brief Set the pressure threshold register for interrupt levels
+ * @param hPa_delta The u16 that will be written to the register, check the
+ * datasheet for more info on the format of this value!
+ */
+void Adafruit_LPS2X::setPresThreshold(uint16_t hPa_delta) {
+  uint8_t buffer[2] = {(uint8_t)(hPa_delta & 0xFF), (uint8_t)(hPa_delta >> 8)};
+  _writeRegisters(threshp_reg, buffer, 2);
+}
+
+/**
+ * @brief Sets the threshold for pressure interrupts in hPa. Events fire when
+ * the pressure rises above the reference by more than this, or falls below it
+ * by more than this
+ * @param hPa_delta The threshold in hPa, 0 to 4095
+ */
+void Adafruit_LPS2X::setPresThresholdHPa(float hPa_delta) {
+  float raw = hPa_delta * 16; // 16 LSB/hPa
+  if (raw < 0) {
+    raw = 0;
+  } else if (raw > 0xFFFF) {
+    raw = 0xFFFF;
+  }
+  setPresThreshold((uint16_t)(raw + 0.5f));
+}
+
+/**
+ * @brief Sets the reference pressure that thresholds are measured against in
+ * `LPS2X_REFERENCE_FIXED` mode. The reference is 0 after a reset, which makes
+ * the thresholds absolute
+ * @param hPa The reference pressure in hPa
+ */
+void Adafruit_LPS2X::setReferencePressure(float hPa) {
+  int32_t raw = (int32_t)(hPa * 4096); // same scale as PRESS_OUT
+  uint8_t buffer[3] = {(uint8_t)(raw & 0xFF), (uint8_t)((raw >> 8) & 0xFF),
+                       (uint8_t)((raw >> 16) & 0xFF)};
+  _writeRegisters(refp_reg, buffer, 3);
+}
+
+/**
+ * @brief Gets the reference pressure, e.g. the value captured by autozero
+ * @returns The reference pressure in hPa
+ */
+float Adafruit_LPS2X::getReferencePressure(void) {
+  uint8_t buffer[3] = {0, 0, 0};
+  _readRegisters(refp_reg, buffer, 3);
+
+  int32_t raw = (int32_t)buffer[2] << 16 | (uint16_t)buffer[1] << 8 | buffer[0];
+  if (raw & 0x800000) {
+    raw -= 0x1000000;
+  }
+  return raw * (1.0f / 4096);
+}
+
+/**
+ * @brief Enables the pressure threshold events set with `setPresThreshold`.
+ * Use the chip's `configureInterrupt` to route them to the INT pin, or poll
+ * `getInterruptSource`
+ * @param pres_high If true, an event fires when the pressure rises above the
+ * reference by more than the threshold
+ * @param pres_low If true, an event fires when the pressure falls below the
+ * reference by more than the threshold
+ * @param latch If true, events stay active until `getInterruptSource` is read
+ */
+void Adafruit_LPS2X::configureThresholdInterrupt(bool pres_high,
+                                                 bool pres_low, bool latch) {
+  _writeBits(&int_cfg_reg, 3, 0, (latch << 2) | (pres_low << 1) | pres_high);
+  _setThresholdEnable(pres_high || pres_low);
+}
+
+/**
+ * @brief Reads which threshold event fired. Reading also clears a latched
+ * interrupt
+ * @returns A combination of `LPS2X_INT_PRES_HIGH`, `LPS2X_INT_PRES_LOW` and
+ * `LPS2X_INT_ACTIVE`, or 0 if INT_SOURCE could not be read
+ */
+uint8_t Adafruit_LPS2X::getInterruptSource(void) {
+  uint8_t source = 0;
+  _readRegister(LPS2X_INT_SOURCE, &source);
+  return source & 0x07;
+}
+
+/**
+ * @brief Starts a measurement without waiting for it to complete. In
+ * one-shot mode this triggers a single conversion; in continuous modes the
+ * sensor is already converting and this does nothing. Use
+ * `isMeasurementReady` to check for completion
+ * @returns True if the conversion was started, false if writing ONE_SHOT
+ * failed
+ */
+bool Adafruit_LPS2X::startMeasurement(void) {
+  // ONE_SHOT self-clears, so it is never kept in the shadow copy
+  if (isOneShot &&
+      !_writeRegister(ctrl2_reg.address, ctrl2_reg.value | 0x01)) {
+    return false;
+  }
+  measurementPending = true;
+  measurementStart = millis();
+  return true;
+}
+
+/**
+ * @brief Checks the STATUS register for a completed conversion
+ *
+ * @return true: new pressure and temperature data is available
+ * @return false: the conversion is still in progress, or STATUS could not be
+ * read
+ */
+bool Adafruit_LPS2X::isMeasurementReady(void) {
+  bool ready = false;
+  _pollReady(&ready);
+  return ready;
+}
+
+/*!
+ *     @brief  Reads STATUS to check for a completed conversion, telling a
+ *             bus error apart from data that is not ready yet
+ *     @param  ready Set to true if new pressure and temperature data is
+ *             available
+ *     @returns True if STATUS was read
+ */
+bool Adafruit_LPS2X::_pollReady(bool *ready) {
+  uint8_t status;
+  if (!_readRegister(LPS2X_STATUS, &status)) {
+    return false;
+  }
+  // P_DA and T_DA are the low two bits on both chips, though in a different
+  // order
+  *ready = (status & 0x03) == 0x03;
+  return true;
+}
+
+/**
+ * @brief Reads the result of a completed measurement without starting a new
+ * one
+ * @param  pressure Sensor event object that will be populated with pressure
+ * data
+ * @param  temp Sensor event object that will be populated with temp data
+ * @returns True if the data was read, false on a bus error
+ */
+bool Adafruit_LPS2X::readMeasurement(sensors_event_t *pressure,
+                                     sensors_event_t *temp) {
+  measurementPending = false;
+  if (!_readData()) {
+    return false;
+  }
+
+  fillPressureEvent(pressure, sampleMillis);
+  fillTempEvent(temp, sampleMillis);
+  return true;
+}
+
+/**
+ * @brief Advances a non-blocking measurement by one step. Call this
+ * repeatedly from the main loop; it starts a conversion when needed, checks
+ * whether it has finished and reads it once it has, never waiting on the
+ * sensor. The check and the read share a single bus transaction
+ * @param  pressure Sensor event object that will be populated with pressure
+ * data
+ * @param  temp Sensor event object that will be populated with temp data
+ * @returns True if new data was read into the events
+ */
+bool Adafruit_LPS2X::poll(sensors_event_t *pressure, sensors_event_t *temp) {
+  if (isOneShot && !measurementPending) {
+    startMeasurement();
+    return false;
+  }
+  if (!_readDataIfReady()) {
+    if (isOneShot && (millis() - measurementStart) >= LPS2X_TIMEOUT_MS) {
+      // the conversion never finished, e.g. it was lost to a reset, so give
+      // up on it and start another
+      bus_stats.timeouts++;
+      measurementPending = false;
+      startMeasurement();
+    }
+    return false;
+  }
+  measurementPending = false;
+
+  fillPressureEvent(pressure, sampleMillis);
+  fillTempEvent(temp, sampleMillis);
+  return true;
+}
+
+/******************* Adafruit_Sensor functions *****************/
+/*!
+ *     @brief  Updates the measurement data for all sensors simultaneously
+ *     @returns True if the read succeeded
+ */
+/**************************************************************************/
+bool Adafruit_LPS2X::_read(void) {
+  return _waitForMeasurement() && _readData();
+}
+
+/*!
+ *     @brief  In one-shot mode, starts a conversion and waits for it to
+ *             finish. Does nothing in continuous modes
+ *     @returns False on a bus error or if the conversion did not finish
+ *              within `LPS2X_TIMEOUT_MS`
+ */
+bool Adafruit_LPS2X::_waitForMeasurement(void) {
+  measurementPending = false;
+  if (!isOneShot) {
+    return true;
+  }
+
+  // for one-shot mode, must manually initiate a reading
+  if (!startMeasurement()) {
+    return false;
+  }
+  uint32_t start = millis();
+  bool ready = false;
+  while (true) {
+    if (!_pollReady(&ready)) {
+      return false;
+    }
+    if (ready) {
+      return true;
+    }
+    if ((millis() - start) >= LPS2X_TIMEOUT_MS) {
+      bus_stats.timeouts++;
+      return false;
+    }
+    delay(1); // wait for completion
+  }
+}
+
+/*!
+ *     @brief  Waits for and reads a new sample. Unlike `_read`, in continuous
+ *             modes this never returns the same sample twice
+ *     @returns True if a sample was read, false if none arrived within two
+ *              output data periods
+ */
+bool Adafruit_LPS2X::_waitForSample(void) {
+  if (isOneShot) {
+    return _read();
+  }
+
+  uint32_t timeout = 2 * samplePeriod / 1000 + 10;
+  uint32_t start = millis();
+  while (!_readDataIfReady()) {
+    if ((millis() - start) >= timeout) {
+      bus_stats.timeouts++;
+      return false;
+    }
+    delay(1);
+  }
+  return true;
+}
+
+/*!
+ *     @brief  Reads the latest pressure and temperature output registers
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::_readData(void) {
+  // PRESS_OUT_XL..TEMP_OUT_H (0x28-0x2C) are contiguous, so both values can
+  // be fetched with a single auto-incrementing read
+  uint8_t buffer[5];
+  bool pressure_only = _skipTemperature();
+  if (!_readRegisters(LPS2X_PRESS_OUT_XL, buffer, pressure_only ? 3 : 5)) {
+    return false;
+  }
+
+  _storeSample(buffer, pressure_only);
+  return true;
+}
+
+/*!
+ *     @brief  Reads STATUS and the output registers in one burst, which over
+ *             SPI keeps CS asserted for the whole check-and-read, and keeps
+ *             the data only if a new sample was flagged
+ *     @returns True if a new sample was read
+ */
+bool Adafruit_LPS2X::_readDataIfReady(void) {
+  // STATUS (0x27) sits directly before PRESS_OUT_XL
+  uint8_t buffer[6];
+  bool pressure_only = _skipTemperature();
+  uint8_t ready = pressure_only ? pres_ready_flag : 0x03;
+  if (!_readRegisters(LPS2X_STATUS, buffer, pressure_only ? 4 : 6)) {
+    return false;
+  }
+  if ((buffer[0] & ready) != ready) {
+    return false;
+  }
+
+  _storeSample(buffer + 1, pressure_only);
+  return true;
+}
+
+/*!
+ *     @brief  Checks whether the next read can skip TEMP_OUT and serve the
+ *             cached temperature instead. Only done with the FIFO bypassed,
+ *             where the output registers hold just the latest sample
+ *     @returns True if only PRESS_OUT should be read
+ */
+bool Adafruit_LPS2X::_skipTemperature(void) {
+  return tempCountdown > 0 && _fifoBypassed();
+}
+
+/*!
+ *     @brief  Checks the shadow FIFO_CTRL for bypass mode
+ *     @returns True if the FIFO is bypassed
+ */
+bool Adafruit_LPS2X::_fifoBypassed(void) {
+  return (fifo_ctrl_reg.value & 0xE0) == 0; // F_MODE is 0 on both chips
+}
+
+/*!
+ *     @brief  Converts and stores a freshly read sample as the latest one
+ *     @param  buffer The raw PRESS_OUT_XL.. bytes, five of them unless
+ *             `pressure_only`
+ *     @param  pressure_only True if only the three PRESS_OUT bytes were read
+ *             and the cached temperature is kept
+ */
+void Adafruit_LPS2X::_storeSample(const uint8_t *buffer, bool pressure_only) {
+  if (pressure_only) {
+    _pressure = _decodeRawPressure(buffer) * (1.0f / 4096);
+    tempCountdown--;
+  } else {
+    _decode(buffer, &_pressure, &_temp);
+    tempCountdown = tempDivider - 1;
+  }
+  // the time of the read; STATUS does not say when the data became ready
+  sampleTime = micros();
+  sampleMillis = millis();
+  // the cached temperature is older than this sample, so the Temp sensor
+  // must not be served from it
+  sampleConsumers = pressure_only ? LPS2X_CONSUMER_TEMP : 0;
+}
+
+/*!
+ *     @brief  Updates the measurement data for one of the unified sensors,
+ *             reusing the last sample when caching is enabled, the sensor
+ *             has not yet been given that sample and the chip cannot have
+ *             produced a newer one
+ *     @param  consumer `LPS2X_CONSUMER_TEMP` or `LPS2X_CONSUMER_PRESSURE`
+ *     @returns True if the data is valid
+ */
+bool Adafruit_LPS2X::_readCached(uint8_t consumer) {
+  if (!sampleCaching || (sampleConsumers & consumer) ||
+      (samplePeriod && (uint32_t)(micros() - sampleTime) >= samplePeriod)) {
+    if (consumer == LPS2X_CONSUMER_TEMP) {
+      tempCountdown = 0; // a temperature was asked for, so read a fresh one
+    }
+    if (!_read()) {
+      return false;
+    }
+  }
+  sampleConsumers |= consumer;
+  return true;
+}
+
+/**
+ * @brief Gets the number of unread samples in the FIFO
+ *
+ * @return uint8_t The number of samples waiting, 0-32, or 0 if FIFO_STATUS
+ * could not be read
+ */
+uint8_t Adafruit_LPS2X::getFifoLevel(void) {
+  uint8_t level = 0;
+  _readFifoLevel(&level);
+  return level;
+}
+
+/**
+ * @brief Drains the samples waiting in the FIFO with a single burst read
+ *
+ * @param samples Array to hold the samples read
+ * @param max_samples The maximum number of samples `samples` can hold
+ * @param timestamps Optional array to hold when each sample was converted,
+ * in `micros()`. The newest sample in the FIFO is taken to be current and
+ * older ones are spaced one output data period apart
+ * @return uint8_t The number of samples read
+ */
+uint8_t Adafruit_LPS2X::readFifo(lps2x_sample_t *samples, uint8_t max_samples,
+                                 uint32_t *timestamps) {
+  uint8_t level;
+  if (!_readFifoLevel(&level)) {
+    return 0;
+  }
+  uint32_t now = micros();
+  uint8_t count = (level > max_samples) ? max_samples : level;
+
+  count = _readSamples(samples, count);
+  if (timestamps) {
+    // the oldest samples are read first
+    for (uint8_t i = 0; i < count; i++) {
+      timestamps[i] = now - (uint32_t)(level - 1 - i) * samplePeriod;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Gets when the last sample read by `getEvent`, `poll`,
+ * `readMeasurement` or the unified sensors was read, with microsecond
+ * resolution. The events carry the same time in `millis()`. This is the time
+ * the sample was read, not converted: in continuous mode the chip may have
+ * converted it up to one output data period earlier
+ *
+ * @return uint32_t The `micros()` time the last sample was read
+ */
+uint32_t Adafruit_LPS2X::getSampleTime(void) { return sampleTime; }
+
+/**
+ * @brief Gets the time between samples at the current data rate
+ *
+ * @return uint32_t The output data period in us, 0 in one-shot mode
+ */
+uint32_t Adafruit_LPS2X::getSamplePeriod(void) { return samplePeriod; }
+
+/*!
+ *     @brief  Reads queued samples out of the FIFO with one burst read
+ *     @param  samples Array to hold the decoded samples
+ *     @param  count The number of samples to read, at most `LPS2X_FIFO_DEPTH`
+ *     @returns The number of samples read
+ */
+uint8_t Adafruit_LPS2X::_readSamples(lps2x_sample_t *samples, uint8_t count) {
+  if (count > LPS2X_FIFO_DEPTH) {
+    count = LPS2X_FIFO_DEPTH;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  uint8_t buffer[LPS2X_FIFO_DEPTH * 5];
+  if (!_readRawRecords(buffer, count)) {
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    _decode(buffer + (i * 5), &samples[i].pressure, &samples[i].temperature);
+  }
+  return count;
+}
+
+/*!
+ *     @brief  Reads raw five byte PRESS_OUT_XL..TEMP_OUT_H records with one
+ *             burst read. The output registers roll over from TEMP_OUT_H back
+ *             to PRESS_OUT_XL while the FIFO is enabled, so consecutive FIFO
+ *             samples come out back to back
+ *     @param  buffer Buffer of at least `count` * 5 bytes
+ *     @param  count The number of records to read, at most `LPS2X_FIFO_DEPTH`
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::_readRawRecords(uint8_t *buffer, uint8_t count) {
+  return _readRegisters(LPS2X_PRESS_OUT_XL, buffer, count * 5);
+}
+
+/*!
+ *     @brief  Converts a raw PRESS_OUT_XL..TEMP_OUT_H record to hPa and C
+ *     @param  buffer The five raw output register bytes, LSB first
+ *     @param  pressure Pointer to store the pressure in hPa
+ *     @param  temp Pointer to store the temperature in C
+ */
+void Adafruit_LPS2X::_decode(const uint8_t *buffer, float *pressure,
+                             float *temp) {
+  int32_t raw_pressure;
+  int16_t raw_temp;
+
+  _decodeRaw(buffer, &raw_pressure, &raw_temp);
+
+  *temp = (raw_temp / temp_scaling) + temp_offset;
+  // a multiply by an exact float constant keeps this out of double math
+  *pressure = raw_pressure * (1.0f / 4096);
+}
+
+/*!
+ *     @brief  Assembles the raw counts from a PRESS_OUT_XL..TEMP_OUT_H record
+ *     @param  buffer The five raw output register bytes, LSB first
+ *     @param  pressure Pointer to store the raw pressure
+ *     @param  temp Pointer to store the raw temperature
+ */
+void Adafruit_LPS2X::_decodeRaw(const uint8_t *buffer, int32_t *pressure,
+                                int16_t *temp) {
+  // TEMP_OUT is already 16-bit two's complement
+  *pressure = _decodeRawPressure(buffer);
+  *temp = (int16_t)(((uint16_t)buffer[4] << 8) | buffer[3]);
+}
+
+/*!
+ *     @brief  Assembles the raw pressure count from PRESS_OUT_XL..H
+ *     @param  buffer The three raw pressure bytes, LSB first
+ *     @returns The raw pressure, 4096 LSB/hPa
+ */
+int32_t Adafruit_LPS2X::_decodeRawPressure(const uint8_t *buffer) {
+  int32_t raw_pressure;
+
+  raw_pressure = (int32_t)buffer[2];
+  raw_pressure <<= 8;
+  raw_pressure |= (int32_t)(buffer[1]);
+  raw_pressure <<= 8;
+  raw_pressure |= (int32_t)(buffer[0]);
+
+  // sign extend the 24-bit two's complement value
+  if (raw_pressure & 0x800000) {
+    raw_pressure -= 0x1000000;
+  }
+  return raw_pressure;
+}
+
+/*!
+ *     @brief  Reads the raw pressure and temperature counts without any
+ *             floating point conversion. In one-shot mode this starts a
+ *             conversion and waits for it first
+ *     @param  sample The raw sample to fill, timestamped with `micros()`
+ *             when it was read. Left unchanged if the read fails
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::readRaw(lps2x_raw_sample_t *sample) {
+  uint8_t buffer[5];
+
+  if (!_waitForMeasurement() || !_readRawRecords(buffer, 1)) {
+    return false;
+  }
+  sample->timestamp = micros();
+  _decodeRaw(buffer, &sample->pressure, &sample->temperature);
+  return true;
+}
+
+/*!
+ *     @brief  Reads the pressure and temperature using integer math only
+ *     @param  pressure Pointer to store the pressure in Pa * 16
+ *     @param  temp Pointer to store the temperature in hundredths of a
+ *             degree C
+ *     @returns True if the read succeeded. Neither value is changed
+ *              otherwise
+ */
+bool Adafruit_LPS2X::readFixed(int32_t *pressure, int16_t *temp) {
+  lps2x_raw_sample_t raw;
+
+  if (!readRaw(&raw)) {
+    return false;
+  }
+  *pressure = rawToPressureFixed(raw.pressure);
+  *temp = rawToTemperatureFixed(raw.temperature);
+  return true;
+}
+
+/*!
+ *     @brief  Converts a raw pressure count to Pa * 16 using integer math
+ *     @param  raw_pressure The raw pressure, 4096 LSB/hPa
+ *     @returns The pressure in Pa * 16
+ */
+int32_t Adafruit_LPS2X::rawToPressureFixed(int32_t raw_pressure) {
+  // raw / 4096 hPa * 100 Pa/hPa * 16 == raw * 25 / 64
+  return (raw_pressure * 25 + 32) >> 6;
+}
+
+/*!
+ *     @brief  Converts a raw temperature count to hundredths of a degree C
+ *             using integer math
+ *     @param  raw_temp The raw temperature
+ *     @returns The temperature in hundredths of a degree C
+ */
+int16_t Adafruit_LPS2X::rawToTemperatureFixed(int16_t raw_temp) {
+  return (int16_t)((((int32_t)raw_temp * temp_scaling_fixed + 0x8000) >> 16) +
+                   temp_offset_fixed);
+}
+
+/*************************** Register access ***************************/
+/*!
+ *     @brief  Gets which kind of bus the sensor is on, as the register
+ *             address flags differ between I2C and SPI
+ *     @returns True for SPI
+ */
+bool Adafruit_LPS2X::_busIsSPI(void) {
+  if (transport) {
+    return transport->isSPI();
+  }
+#ifdef LPS2X_HAS_BUSIO
+  return spi_dev != NULL;
+#else
+  return false;
+#endif
+}
+
+/*!
+ *     @brief  Writes a register address and reads the registers back as one
+ *             transaction on whichever bus the sensor was started on
+ *     @param  addr The register address, with flags already set
+ *     @param  buffer Buffer to hold the register contents
+ *     @param  len The number of registers to read
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::_busRead(uint8_t addr, uint8_t *buffer, uint8_t len) {
+  if (transport) {
+    return transport->read(addr, buffer, len);
+  }
+#ifdef LPS2X_HAS_BUSIO
+  if (i2c_dev) {
+    return i2c_dev->write_then_read(&addr, 1, buffer, len);
+  }
+  if (spi_dev) {
+    return spi_dev->write_then_read(&addr, 1, buffer, len);
+  }
+#endif
+  return false;
+}
+
+/*!
+ *     @brief  Writes a register address followed by the values as one
+ *             transaction on whichever bus the sensor was started on
+ *     @param  addr The register address, with flags already set
+ *     @param  buffer The values to write
+ *     @param  len The number of registers to write
+ *     @returns True if the write succeeded
+ */
+bool Adafruit_LPS2X::_busWrite(uint8_t addr, const uint8_t *buffer,
+                               uint8_t len) {
+  if (transport) {
+    return transport->write(addr, buffer, len);
+  }
+#ifdef LPS2X_HAS_BUSIO
+  if (i2c_dev) {
+    return i2c_dev->write(buffer, len, true, &addr, 1);
+  }
+  if (spi_dev) {
+    return spi_dev->write(buffer, len, &addr, 1);
+  }
+#endif
+  return false;
+}
+
+/*!
+ *     @brief  Reads one or more consecutive registers in a single transaction
+ *     @param  reg The first register address
+ *     @param  buffer Buffer to hold the register contents
+ *     @param  len The number of registers to read
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::_readRegisters(uint8_t reg, uint8_t *buffer,
+                                    uint8_t len) {
+  uint8_t addr = reg & 0x7F;
+  uint8_t overhead = 1;
+  bool spi = _busIsSPI();
+
+  if (!spi) {
+    // device address for the write and the read, then the register address
+    overhead = 3;
+    if (len > 1) {
+      addr |= 0x80; // auto increment on multi-byte read
+    }
+  } else {
+    // addr[7] is r/w, and for LPS25 SPI addr[6] is auto increment
+    addr |= 0x80;
+    if (len > 1) {
+      addr |= inc_spi_flag;
+    }
+  }
+
+  uint32_t start = micros();
+  uint8_t attempt = 0;
+  bool ok;
+  do {
+    bus_stats.transactions++;
+    bus_stats.bytes += overhead + len;
+    ok = _busRead(addr, buffer, len);
+  } while (!ok && _retry(attempt++));
+
+  _endTransaction(start, ok);
+  return ok;
+}
+
+/*!
+ *     @brief  Reads a single register
+ *     @param  reg The register address
+ *     @param  value Where to store the register contents
+ *     @returns True if the read succeeded
+ */
+bool Adafruit_LPS2X::_readRegister(uint8_t reg, uint8_t *value) {
+  return _readRegisters(reg, value, 1);
+}
+
+/*!
+ *     @brief  Writes one or more consecutive registers in a single
+ *             transaction
+ *     @param  reg The first register address
+ *     @param  buffer The values to write
+ *     @param  len The number of registers to write
+ *     @returns True if the write succeeded
+ */
+bool Adafruit_LPS2X::_writeRegisters(uint8_t reg, const uint8_t *buffer,
+                                     uint8_t len) {
+  uint8_t addr = reg & 0x7F;
+  uint8_t overhead = 1;
+  bool spi = _busIsSPI();
+
+  if (!spi) {
+    overhead = 2;
+    if (len > 1) {
+      addr |= 0x80;
+    }
+  } else if (len > 1) {
+    addr |= inc_spi_flag;
+  }
+
+  uint32_t start = micros();
+  uint8_t attempt = 0;
+  bool ok;
+  do {
+    bus_stats.transactions++;
+    bus_stats.bytes += overhead + len;
+    ok = _busWrite(addr, buffer, len);
+  } while (!ok && _retry(attempt++));
+
+  _endTransaction(start, ok);
+  return ok;
+}
+
+/*!
+ *     @brief  Decides whether to repeat a failed transaction, waiting out
+ *             the backoff first. The backoff doubles with each retry
+ *     @param  attempt The number of retries already made
+ *     @returns True to try again
+ */
+bool Adafruit_LPS2X::_retry(uint8_t attempt) {
+  if (attempt >= busRetries) {
+    return false;
+  }
+  bus_stats.retries++;
+
+  uint32_t wait = (uint32_t)busBackoff << attempt;
+  if (wait >= 1000) {
+    delay(wait / 1000);
+  }
+  delayMicroseconds(wait % 1000);
+  return true;
+}
+
+/*!
+ *     @brief  Records the outcome of a transaction in the bus statistics
+ *     @param  start `micros()` before the first attempt
+ *     @param  ok True if the transaction eventually succeeded
+ */
+void Adafruit_LPS2X::_endTransaction(uint32_t start, bool ok) {
+  uint32_t latency = micros() - start;
+  if (latency > bus_stats.max_latency) {
+    bus_stats.max_latency = latency;
+  }
+  if (!ok) {
+    bus_stats.failures++;
+  }
+}
+
+/*!
+ *     @brief  Writes a single register
+ *     @param  reg The register address
+ *     @param  value The value to write
+ *     @returns True if the write succeeded
+ */
+bool Adafruit_LPS2X::_writeRegister(uint8_t reg, uint8_t value) {
+  return _writeRegisters(reg, &value, 1);
+}
+
+/*!
+ *     @brief  Updates a bit field of a shadowed register. The new value is
+ *             computed from the shadow copy, so no read is needed first
+ *     @param  reg The shadowed register to update
+ *     @param  bits The width of the field
+ *     @param  shift The position of the field's lowest bit
+ *     @param  value The new field value
+ *     @returns True if the write succeeded
+ */
+bool Adafruit_LPS2X::_writeBits(lps2x_shadow_reg_t *reg, uint8_t bits,
+                                uint8_t shift, uint8_t value) {
+  uint8_t mask = ((1 << bits) - 1) << shift;
+  uint8_t new_value = (reg->value & ~mask) | ((value << shift) & mask);
+
+  if (new_value == reg->value) {
+    return true; // the shadow matches the chip, nothing to write
+  }
+  if (!_writeRegister(reg->address, new_value)) {
+    return false;
+  }
+  reg->value = new_value;
+  return true;
+}
+
+/*!
+ *     @brief  Reads a bit field from the shadow copy of a register
+ *     @param  reg The shadowed register to read
+ *     @param  bits The width of the field
+ *     @param  shift The position of the field's lowest bit
+ *     @returns The field value
+ */
+uint8_t Adafruit_LPS2X::_readBits(const lps2x_shadow_reg_t *reg, uint8_t bits,
+                                  uint8_t shift) {
+  return (reg->value >> shift) & ((1 << bits) - 1);
+}
 
-#include "Adafruit_LPS2X.h"
+/*!
+ *     @brief  Refreshes the shadow copies from the chip, e.g. after a reset.
+ *             CTRL_REG1-3 are contiguous on both chips, so they are fetched
+ *             together
+ *     @returns True if the control registers were read
+ */
+bool Adafruit_LPS2X::_loadShadowRegisters(void) {
+  uint8_t buffer[3];
 
-/**
- * @brief Construct a new Adafruit_LPS2X::Adafruit_LPS2X object
- *
+  if (!_readRegisters(ctrl1_reg.address, buffer, 3)) {
+    return false;
+  }
+  ctrl1_reg.value = buffer[0];
+  ctrl2_reg.value = buffer[1] & ~0x05; // without ONE_SHOT and SWRESET
+  ctrl3_reg.value = buffer[2];
+  if (!_readRegister(fifo_ctrl_reg.address, &fifo_ctrl_reg.value) ||
+      !_readRegister(res_conf_reg.address, &res_conf_reg.value) ||
+      !_readRegister(int_cfg_reg.address, &int_cfg_reg.value)) {
+    return false;
+  }
+  if (ctrl4_reg.address &&
+      !_readRegister(ctrl4_reg.address, &ctrl4_reg.value)) {
+    return false; // only the LPS25 has a CTRL_REG4
+  }
+
+  // RPDS survives a fast init, so learn what the chip already applies
+  if (!_readRegisters(rpds_reg, buffer, 2)) {
+    return false;
+  }
+  rpdsValue = (int16_t)((uint16_t)buffer[1] << 8 | buffer[0]);
+  return true;
+}
+
+/*!
+ *     @brief  Brings the shadow copies in sync with the chip at the start of
+ *             `_init`. Normally this is a software reset, but with fast init
+ *             the running configuration is read back instead so that only
+ *             the registers that differ from the defaults get rewritten
+ *     @returns True if the chip responded
  */
-Adafruit_LPS2X::Adafruit_LPS2X(void) {}
+bool Adafruit_LPS2X::_prepareRegisters(void) {
+  if (fastInit) {
+    return _loadShadowRegisters();
+  }
+  return reset();
+}
 
 /*!
- *    @brief  Sets up the hardware and initializes I2C
- *    @param  i2c_address
- *            The I2C address to be used.
- *    @param  wire
- *            The Wire object to be used for I2C connections.
- *    @param  sensor_id
- *            The unique ID to differentiate the sensors from others
- *    @return True if initialization was successful, otherwise false.
+ *     @brief  Waits for the first sample at the end of `_init`. With fast
+ *             init STATUS is polled, returning as soon as data is available
+ *             and giving up one output data period (plus margin) later;
+ *             otherwise a fixed delay is used
  */
-bool Adafruit_LPS2X::begin_I2C(uint8_t i2c_address, TwoWire *wire,
-                               int32_t sensor_id) {
-  spi_dev = NULL;
-  if (i2c_dev) {
-    delete i2c_dev; // remove old interface
+void Adafruit_LPS2X::_waitForFirstSample(void) {
+  if (!fastInit) {
+    delay(10); // delay for first reading
+    return;
+  }
+  if (isOneShot) {
+    return; // nothing converts until a measurement is started
   }
 
-  i2c_dev = new Adafruit_I2CDevice(i2c_address, wire);
+  uint32_t timeout = samplePeriod / 1000 + 10;
+  uint32_t start = millis();
+  bool ready = false;
+  while (_pollReady(&ready) && !ready) {
+    if ((millis() - start) >= timeout) {
+      bus_stats.timeouts++;
+      return;
+    }
+    delay(1);
+  }
+}
 
-  if (!i2c_dev->begin()) {
-    return false;
+/*!
+ *     @brief  Gets the bus traffic generated by the driver since `begin_*`
+ *             or the last `resetBusStats`. Useful for measuring the cost of
+ *             an operation on real hardware
+ *     @param  stats The counters to fill
+ */
+void Adafruit_LPS2X::getBusStats(lps2x_bus_stats_t *stats) {
+  *stats = bus_stats;
+}
+
+/*!
+ *     @brief  Zeroes the bus traffic counters
+ */
+void Adafruit_LPS2X::resetBusStats(void) {
+  memset(&bus_stats, 0, sizeof(bus_stats));
+}
+
+/*!
+ *     @brief  Sets how often a failed bus transaction is repeated before it
+ *             is reported as an error. Each retry waits twice as long as the
+ *             one before. Off by default, so a missing sensor fails fast
+ *     @param  retries The number of retries, 0 to disable
+ *     @param  backoff_us The wait before the first retry in microseconds
+ */
+void Adafruit_LPS2X::setBusRetries(uint8_t retries, uint16_t backoff_us) {
+  busRetries = retries;
+  busBackoff = backoff_us;
+}
+
+/**************************** Duty cycling *****************************/
+/*!
+ *     @brief  Sets up duty cycled logging: the sensor stays powered down and
+ *             is woken for a single one-shot conversion every `interval_ms`,
+ *             then powered down again. Call `updateDutyCycle` from the main
+ *             loop to drive it
+ *     @param  interval_ms Milliseconds between samples, or 0 to stop duty
+ *             cycling and leave the sensor awake in one-shot mode
+ */
+void Adafruit_LPS2X::setDutyCycle(uint32_t interval_ms) {
+  dutyInterval = interval_ms;
+  dutyAwake = false;
+  measurementPending = false;
+  if (!interval_ms) {
+    _setDutyCyclePower(true); // stay awake for one-shot reads
+    return;
   }
 
-  return _init(sensor_id);
+  _setupDutyCycle();
+  _setDutyCyclePower(false);
+  // take the first sample right away
+  dutyLastWake = millis() - interval_ms;
 }
 
 /*!
- *    @brief  Sets up the hardware and initializes hardware SPI
- *    @param  cs_pin The arduino pin # connected to chip select
- *    @param  theSPI The SPI object to be used for SPI connections.
- *    @param  sensor_id
- *            The user-defined ID to differentiate different sensors
- *    @return True if initialization was successful, otherwise false.
+ *     @brief  Advances duty cycled logging by one step without blocking. Wakes
+ *             the sensor and starts a conversion when the interval has
+ *             passed, then reads the result and powers the sensor back down
+ *             once it is ready
+ *     @param  pressure Sensor event object that will be populated with
+ *             pressure data
+ *     @param  temp Sensor event object that will be populated with temp data
+ *     @returns True if a new sample was read into the events
  */
-bool Adafruit_LPS2X::begin_SPI(uint8_t cs_pin, SPIClass *theSPI,
-                               int32_t sensor_id) {
-  i2c_dev = NULL;
+bool Adafruit_LPS2X::updateDutyCycle(sensors_event_t *pressure,
+                                     sensors_event_t *temp) {
+  if (!dutyInterval) {
+    return false;
+  }
 
-  if (spi_dev) {
-    delete spi_dev; // remove old interface
+  if (!dutyAwake) {
+    uint32_t now = millis();
+    uint32_t elapsed = now - dutyLastWake;
+    if (elapsed < dutyInterval) {
+      return false;
+    }
+    if (elapsed >= 2 * dutyInterval) {
+      // the loop stalled, so resync rather than catch up with a burst of
+      // back to back wakes
+      dutyLastWake = now;
+    } else {
+      dutyLastWake += dutyInterval;
+    }
+    dutyWakeMicros = micros();
+    if (!_setDutyCyclePower(true) || !startMeasurement()) {
+      // nothing is converting, so sleep and try again next interval
+      _setDutyCyclePower(false);
+      return false;
+    }
+    dutyAwake = true;
+    return false;
   }
-  spi_dev = new Adafruit_SPIDevice(cs_pin,
-                                   1000000,               // frequency
-                                   SPI_BITORDER_MSBFIRST, // bit order
-                                   SPI_MODE0,             // data mode
-                                   theSPI);
-  if (!spi_dev->begin()) {
+
+  if (!_readDataIfReady()) {
+    if ((millis() - measurementStart) >= LPS2X_TIMEOUT_MS) {
+      // the conversion never finished, so give up on this interval
+      bus_stats.timeouts++;
+      _setDutyCyclePower(false);
+      dutyAwake = false;
+      measurementPending = false;
+    }
     return false;
   }
+  // a failed power down is retried after the next sample, as the shadow
+  // still shows the sensor awake
+  _setDutyCyclePower(false);
+  dutyAwake = false;
+  measurementPending = false;
+  dutyActiveTime = micros() - dutyWakeMicros;
 
-  return _init(sensor_id);
+  fillPressureEvent(pressure, sampleMillis);
+  fillTempEvent(temp, sampleMillis);
+  return true;
 }
 
 /*!
- *    @brief  Sets up the hardware and initializes software SPI
- *    @param  cs_pin The arduino pin # connected to chip select
- *    @param  sck_pin The arduino pin # connected to SPI clock
- *    @param  miso_pin The arduino pin # connected to SPI MISO
- *    @param  mosi_pin The arduino pin # connected to SPI MOSI
- *    @param  sensor_id
- *            The user-defined ID to differentiate different sensors
- *    @return True if initialization was successful, otherwise false.
+ *     @brief  Gets how long the sensor was awake for the last duty cycled
+ *             sample, from wake-up until it was powered down again
+ *     @returns The active time in microseconds
  */
-bool Adafruit_LPS2X::begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
-                               int8_t mosi_pin, int32_t sensor_id) {
-  i2c_dev = NULL;
+uint32_t Adafruit_LPS2X::getActiveTime(void) { return dutyActiveTime; }
 
-  if (spi_dev) {
-    delete spi_dev; // remove old interface
+/**************************** Sample buffer ****************************/
+/*!
+ *     @brief  Sets up interrupt driven acquisition into a caller-supplied
+ *             ring of raw samples. Attach an ISR to the INT pin that calls
+ *             `handleInterrupt`, then call `service` from the main loop to
+ *             move ready samples into the ring and `readBufferedSample` to
+ *             take them out at the application's own pace. `service` is the
+ *             only producer and the consumer only moves the read index, so
+ *             the two may run in different contexts without locking
+ *     @param  buffer Storage for the ring, or NULL to disable buffering
+ *     @param  size The number of samples `buffer` holds. Must be a power of
+ *             two, at most 128
+ *     @param  fifo_watermark If true, each interrupt is a FIFO watermark and
+ *             all queued FIFO samples are drained, otherwise each interrupt
+ *             is a single data ready
+ *     @returns True if the buffer was accepted
+ */
+bool Adafruit_LPS2X::enableSampleBuffer(lps2x_raw_sample_t *buffer,
+                                        uint8_t size, bool fifo_watermark) {
+  if (buffer && (size == 0 || size > 128 || (size & (size - 1)))) {
+    return false;
   }
-  spi_dev = new Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin,
-                                   1000000,               // frequency
-                                   SPI_BITORDER_MSBFIRST, // bit order
-                                   SPI_MODE0);            // data mode
-  if (!spi_dev->begin()) {
+
+  noInterrupts();
+  ring = buffer;
+  ring_mask = buffer ? size - 1 : 0;
+  ring_head = 0;
+  ring_tail = 0;
+  ring_dropped = 0;
+  ring_from_fifo = fifo_watermark;
+  irq_pending = false;
+  interrupts();
+  return true;
+}
+
+/*!
+ *     @brief  Records a data ready or FIFO watermark interrupt. Safe to call
+ *             from an ISR as it does not touch the bus
+ */
+void Adafruit_LPS2X::handleInterrupt(void) {
+  irq_timestamp = micros();
+  irq_pending = true;
+}
+
+/*!
+ *     @brief  Reads the sample(s) flagged by `handleInterrupt` into the ring.
+ *             Does nothing if no interrupt has arrived since the last call
+ *     @returns The number of samples added to the ring
+ */
+uint8_t Adafruit_LPS2X::service(void) {
+  if (!ring || !irq_pending) {
+    return 0;
+  }
+
+  noInterrupts();
+  uint32_t timestamp = irq_timestamp;
+  irq_pending = false;
+  interrupts();
+
+  uint8_t buffer[LPS2X_FIFO_DEPTH * 5];
+  uint8_t count = 1;
+  const uint8_t *records = buffer;
+  if (ring_from_fifo) {
+    if (!_readFifoLevel(&count)) {
+      return 0;
+    }
+    if (count > LPS2X_FIFO_DEPTH) {
+      count = LPS2X_FIFO_DEPTH;
+    }
+    if (count == 0 || !_readRawRecords(buffer, count)) {
+      return 0;
+    }
+  } else {
+    // STATUS sits directly before PRESS_OUT_XL, so the same burst tells
+    // whether the sample is new and whether one was overwritten unread
+    // because interrupts arrived faster than they were serviced
+    if (!_readRegisters(LPS2X_STATUS, buffer, 6)) {
+      return 0;
+    }
+    if (buffer[0] & 0x30) { // P_OR or T_OR on both chips
+      ring_dropped++;
+    }
+    if ((buffer[0] & 0x03) != 0x03) {
+      return 0;
+    }
+    records = buffer + 1;
+  }
+
+  // the interrupt marks the conversion of the last sample for data ready, or
+  // of sample number WTM for a watermark, and the rest are spaced one output
+  // data period from it
+  uint8_t anchor = count - 1;
+  uint8_t watermark = fifo_ctrl_reg.value & 0x1F;
+  if (ring_from_fifo && watermark && watermark <= count) {
+    anchor = watermark - 1;
+  }
+
+  uint8_t added = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    int32_t offset = ((int32_t)i - anchor) * (int32_t)samplePeriod;
+    if (_pushSample(timestamp + offset, records + (i * 5))) {
+      added++;
+    }
+  }
+  return added;
+}
+
+/*!
+ *     @brief  Stores one raw record in the ring, dropping it if it is full
+ *     @param  timestamp `micros()` at which the record was converted
+ *     @param  buffer The five raw output register bytes
+ *     @returns True if the sample was stored
+ */
+bool Adafruit_LPS2X::_pushSample(uint32_t timestamp, const uint8_t *buffer) {
+  // acquire pairs with the consumer's release, so a slot is not reused
+  // before it has been copied out
+  uint8_t head = ring_head;
+  uint8_t tail = __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE);
+  if ((uint8_t)(head - tail) > ring_mask) {
+    ring_dropped++;
     return false;
   }
-  return _init(sensor_id);
+
+  lps2x_raw_sample_t *slot = &ring[head & ring_mask];
+  slot->timestamp = timestamp;
+  _decodeRaw(buffer, &slot->pressure, &slot->temperature);
+
+  // publish the slot only once it is written
+  __atomic_store_n(&ring_head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+  return true;
 }
 
-/**
- * @brief Performs a software reset initializing registers to their power on
- * state
+/*!
+ *     @brief  Gets the number of samples waiting in the ring
+ *     @returns The number of unread samples
  */
-void Adafruit_LPS2X::reset(void) {
-  Adafruit_BusIO_RegisterBits sw_reset =
-      Adafruit_BusIO_RegisterBits(ctrl2_reg, 1, 2);
+uint8_t Adafruit_LPS2X::samplesAvailable(void) {
+  uint8_t head = __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE);
+  return (uint8_t)(head - __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE));
+}
 
-  sw_reset.write(1);
-  while (sw_reset.read()) {
-    delay(1);
+/*!
+ *     @brief  Gets the number of samples lost because the ring was full or,
+ *             with data ready interrupts, because the sensor overwrote a
+ *             sample before `service` read it. An overwrite counts as one
+ *             lost sample, though several may have been
+ *     @returns The number of dropped samples since `enableSampleBuffer`
+ */
+uint32_t Adafruit_LPS2X::samplesDropped(void) { return ring_dropped; }
+
+/*!
+ *     @brief  Takes the oldest sample out of the ring
+ *     @param  sample The raw sample to fill
+ *     @returns True if a sample was available
+ */
+bool Adafruit_LPS2X::readBufferedSample(lps2x_raw_sample_t *sample) {
+  // acquire pairs with the producer's release, so the slot is fully written
+  uint8_t tail = ring_tail;
+  if (tail == __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE)) {
+    return false;
   }
+
+  *sample = ring[tail & ring_mask];
+
+  // hand the slot back to the producer only once it is copied
+  __atomic_store_n(&ring_tail, (uint8_t)(tail + 1), __ATOMIC_RELEASE);
+  return true;
 }
 
-/**
- * @brief Set the pressure threshold register for interrupt levels
- * @param hPa_delta The u16 that will be written to the register, check the
- * datasheet for more info on the format of this value!
+/*!
+ *     @brief  Converts a raw sample to hPa and degrees C
+ *     @param  raw The raw sample to convert
+ *     @param  sample The converted sample
  */
-void Adafruit_LPS2X::setPresThreshold(uint16_t hPa_delta) {
-  threshp_reg->write(hPa_delta);
+void Adafruit_LPS2X::convertSample(const lps2x_raw_sample_t *raw,
+                                   lps2x_sample_t *sample) {
+  sample->temperature = (raw->temperature / temp_scaling) + temp_offset;
+  sample->pressure = raw->pressure * (1.0f / 4096);
 }
 
-/******************* Adafruit_Sensor functions *****************/
+/***************************** Calibration *****************************/
 /*!
- *     @brief  Updates the measurement data for all sensors simultaneously
+ *     @brief  Stores a float in four bytes, LSB first
+ *     @param  buffer Where to store the value
+ *     @param  value The value to store
  */
-/**************************************************************************/
-void Adafruit_LPS2X::_read(void) {
-  // get raw readings
-  uint8_t pressure_addr = LPS2X_PRESS_OUT_XL;
-  uint8_t temp_addr = LPS2X_TEMP_OUT_L;
-  if (spi_dev) {
-    // for LPS25 SPI, addr[7] is r/w, addr[6] is auto increment
-    pressure_addr |= inc_spi_flag;
-    temp_addr |= inc_spi_flag;
+static void lps2x_put_float(uint8_t *buffer, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, 4);
+  for (uint8_t i = 0; i < 4; i++) {
+    buffer[i] = (bits >> (8 * i)) & 0xFF;
   }
+}
 
-  // for one-shot mode, must manually initiate a reading
-  if (isOneShot) {
-    Adafruit_BusIO_RegisterBits oneshot_bit =
-        Adafruit_BusIO_RegisterBits(ctrl2_reg, 1, 0);
-    oneshot_bit.write(1); // initiate reading
-    while (oneshot_bit.read())
-      delay(1); // wait for completion
+/*!
+ *     @brief  Loads a float stored by `lps2x_put_float`
+ *     @param  buffer The stored bytes
+ *     @returns The value
+ */
+static float lps2x_get_float(const uint8_t *buffer) {
+  uint32_t bits = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    bits |= (uint32_t)buffer[i] << (8 * i);
   }
+  float value;
+  memcpy(&value, &bits, 4);
+  return value;
+}
 
-  Adafruit_BusIO_Register pressure_data = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, pressure_addr, 3);
+/*!
+ *     @brief  Fletcher-16 checksum of a calibration blob
+ *     @param  buffer The bytes to check
+ *     @param  len The number of bytes
+ *     @returns The checksum
+ */
+static uint16_t lps2x_checksum(const uint8_t *buffer, uint8_t len) {
+  uint16_t sum1 = 0, sum2 = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    sum1 = (sum1 + buffer[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
 
-  Adafruit_BusIO_Register temp_data = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, temp_addr, 2);
+/*!
+ *     @brief  Sets the chip's pressure offset (RPDS), which is subtracted
+ *             from every pressure output in silicon, so it costs nothing per
+ *             sample. Clears any temperature compensation
+ *     @param  hPa The offset in hPa, +/-2047, with a resolution of 1/16 hPa
+ *     @returns True if the write succeeded
+ */
+bool Adafruit_LPS2X::setPressureOffset(float hPa) {
+  calOffset = hPa;
+  calTemperature = 0;
+  tempCoefficient = 0;
+  return updateTemperatureCompensation();
+}
 
-  uint8_t buffer[3];
+/*!
+ *     @brief  Gets the pressure offset currently applied by the chip
+ *     @returns The offset in hPa
+ */
+float Adafruit_LPS2X::getPressureOffset(void) {
+  uint8_t buffer[2] = {0, 0};
+  _readRegisters(rpds_reg, buffer, 2);
+  return (int16_t)((uint16_t)buffer[1] << 8 | buffer[0]) * (1.0f / 16);
+}
 
-  temp_data.read(buffer, 2);
-  int16_t raw_temp;
+/*!
+ *     @brief  Calibrates the pressure offset against a known reference by
+ *             averaging fresh samples, and writes the result to the chip.
+ *             To also compensate temperature drift, calibrate again with
+ *             `temperature_point` set once the sensor is at a different
+ *             temperature; the offset then follows the temperature whenever
+ *             `updateTemperatureCompensation` is called
+ *     @param  reference_hPa The true pressure in hPa
+ *     @param  samples The number of samples to average, at least 1
+ *     @param  temperature_point If true, keep the existing offset and fit
+ *             the temperature coefficient from the two calibrations instead
+ *     @returns True if calibration succeeded, false if the sensor stopped
+ *              responding or, for a temperature point, the temperature had
+ *              changed by less than 1 C
+ */
+bool Adafruit_LPS2X::calibrate(float reference_hPa, uint8_t samples,
+                               bool temperature_point) {
+  if (samples == 0) {
+    samples = 1;
+  }
 
-  raw_temp = (int16_t)(buffer[1]);
-  raw_temp <<= 8;
-  raw_temp |= (int16_t)(buffer[0]);
+  float pressure = 0, temperature = 0;
+  for (uint8_t i = 0; i < samples; i++) {
+    tempCountdown = 0; // every sample needs its temperature
+    if (!_waitForSample()) {
+      return false;
+    }
+    pressure += _pressure;
+    temperature += _temp;
+  }
+  pressure /= samples;
+  temperature /= samples;
 
-  pressure_data.read(buffer, 3);
-  int32_t raw_pressure;
+  // the samples already had the chip's current offset subtracted
+  float applied = getPressureOffset();
+  rpdsValue = (int16_t)(applied * 16);
+  float error = pressure - reference_hPa + applied;
 
-  raw_pressure = (int32_t)buffer[2];
-  raw_pressure <<= 8;
-  raw_pressure |= (int32_t)(buffer[1]);
-  raw_pressure <<= 8;
-  raw_pressure |= (int32_t)(buffer[0]);
+  if (temperature_point) {
+    float delta = temperature - calTemperature;
+    if (delta > -1.0f && delta < 1.0f) {
+      return false;
+    }
+    tempCoefficient = (error - calOffset) / delta;
+  } else {
+    calOffset = error;
+    calTemperature = temperature;
+  }
+  return updateTemperatureCompensation();
+}
 
-  if (raw_temp & 0x8000) {
-    raw_temp = raw_temp - 0xFFFF;
+/*!
+ *     @brief  Sets how much the pressure error changes with temperature, for
+ *             use by `updateTemperatureCompensation`
+ *     @param  hPa_per_C The change in hPa per degree C, 0 to disable
+ */
+void Adafruit_LPS2X::setTemperatureCoefficient(float hPa_per_C) {
+  tempCoefficient = hPa_per_C;
+}
+
+/*!
+ *     @brief  Gets the temperature coefficient of the pressure error
+ *     @returns The change in hPa per degree C
+ */
+float Adafruit_LPS2X::getTemperatureCoefficient(void) {
+  return tempCoefficient;
+}
+
+/*!
+ *     @brief  Rewrites the chip's pressure offset for the last temperature
+ *             read. The register is only written when the offset moves by
+ *             at least one step of 1/16 hPa, so this may be called after
+ *             every read
+ *     @returns True if the offset is up to date
+ */
+bool Adafruit_LPS2X::updateTemperatureCompensation(void) {
+  float offset = calOffset;
+  if (tempCoefficient != 0) {
+    offset += tempCoefficient * (_temp - calTemperature);
   }
-  _temp = (raw_temp / temp_scaling) + temp_offset;
 
-  if (raw_pressure & 0x800000) {
-    raw_pressure = raw_pressure - 0xFFFFFF;
+  float raw = offset * 16; // 16 LSB/hPa
+  if (raw > 32767) {
+    raw = 32767;
+  } else if (raw < -32768) {
+    raw = -32768;
+  }
+  int16_t value = (int16_t)(raw < 0 ? raw - 0.5f : raw + 0.5f);
+  if (value == rpdsValue && !rpdsForce) {
+    return true;
+  }
+
+  uint8_t buffer[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+  if (!_writeRegisters(rpds_reg, buffer, 2)) {
+    return false;
+  }
+  rpdsValue = value;
+  rpdsForce = false;
+  return true;
+}
+
+/*!
+ *     @brief  Stores the calibration in a `LPS2X_CALIBRATION_SIZE` byte blob
+ *             with a checksum, e.g. for EEPROM
+ *     @param  buffer Where to store the blob
+ *     @returns True if the chip's ID could be read into the blob
+ */
+bool Adafruit_LPS2X::saveCalibration(uint8_t *buffer) {
+  buffer[0] = 1; // format version
+  if (!_readRegister(LPS2X_WHOAMI, &buffer[1])) {
+    return false;
+  }
+  lps2x_put_float(buffer + 2, calOffset);
+  lps2x_put_float(buffer + 6, calTemperature);
+  lps2x_put_float(buffer + 10, tempCoefficient);
+
+  uint16_t checksum = lps2x_checksum(buffer, LPS2X_CALIBRATION_SIZE - 2);
+  buffer[LPS2X_CALIBRATION_SIZE - 2] = checksum & 0xFF;
+  buffer[LPS2X_CALIBRATION_SIZE - 1] = checksum >> 8;
+  return true;
+}
+
+/*!
+ *     @brief  Restores a calibration stored by `saveCalibration` and writes
+ *             its offset to the chip. Call after `begin_*`, as a reset
+ *             clears the offset
+ *     @param  buffer The stored blob
+ *     @returns True if the blob was valid for this chip and was applied
+ */
+bool Adafruit_LPS2X::loadCalibration(const uint8_t *buffer) {
+  uint16_t checksum = lps2x_checksum(buffer, LPS2X_CALIBRATION_SIZE - 2);
+  uint8_t id;
+  if (buffer[0] != 1 ||
+      buffer[LPS2X_CALIBRATION_SIZE - 2] != (checksum & 0xFF) ||
+      buffer[LPS2X_CALIBRATION_SIZE - 1] != (checksum >> 8) ||
+      !_readRegister(LPS2X_WHOAMI, &id) || buffer[1] != id) {
+    return false;
   }
-  _pressure = raw_pressure / 4096.0;
+
+  calOffset = lps2x_get_float(buffer + 2);
+  calTemperature = lps2x_get_float(buffer + 6);
+  tempCoefficient = lps2x_get_float(buffer + 10);
+  rpdsForce = true;
+  return updateTemperatureCompensation();
 }
 
 /*!
@@ -213,7 +1584,7 @@ void Adafruit_LPS2X::_read(void) {
     @return Adafruit_Sensor pointer to pressure sensor
  */
 Adafruit_Sensor *Adafruit_LPS2X::getPressureSensor(void) {
-  return pressure_sensor;
+  return &pressure_sensor;
 }
 
 /*!
@@ -221,7 +1592,46 @@ Adafruit_Sensor *Adafruit_LPS2X::getPressureSensor(void) {
     @return Adafruit_Sensor pointer to temperature sensor
  */
 Adafruit_Sensor *Adafruit_LPS2X::getTemperatureSensor(void) {
-  return temp_sensor;
+  return &temp_sensor;
+}
+
+/*!
+ *    @brief  Lets the temperature and pressure unified sensors share one
+ *            bus read. With caching enabled, a unified sensor's `getEvent`
+ *            reuses the last sample if the other sensor triggered the read
+ *            and, in continuous modes, less than one output data period has
+ *            passed since. Each sensor still gets a fresh read the second
+ *            time it is asked for the same sample
+ *    @param  enable True to enable caching
+ */
+void Adafruit_LPS2X::setSampleCaching(bool enable) {
+  sampleCaching = enable;
+  sampleConsumers = LPS2X_CONSUMER_TEMP | LPS2X_CONSUMER_PRESSURE;
+}
+
+/*!
+ *    @brief  Speeds up `begin_*` for sensors that are already configured,
+ *            e.g. after a watchdog reset of the host. Instead of a software
+ *            reset, the control registers are read back and only those that
+ *            differ from the defaults are written, and the fixed startup
+ *            delay is replaced by polling STATUS for the first sample.
+ *            Settings outside the defaults, such as the FIFO mode, are
+ *            kept from the previous run. Call before `begin_*`
+ *    @param  enable True to enable fast init
+ */
+void Adafruit_LPS2X::setFastInit(bool enable) { fastInit = enable; }
+
+/*!
+ *    @brief  Reads the temperature only every `divider` samples, for high
+ *            rate pressure tracking. The other reads fetch just the three
+ *            PRESS_OUT bytes and report the last temperature read. The
+ *            temperature unified sensor and `calibrate` still get a fresh
+ *            temperature. Has no effect while the FIFO is enabled
+ *    @param  divider Samples per temperature read, 1 to read it every time
+ */
+void Adafruit_LPS2X::setTemperatureDivider(uint8_t divider) {
+  tempDivider = divider ? divider : 1;
+  tempCountdown = 0;
 }
 
 /**************************************************************************/
@@ -230,37 +1640,146 @@ Adafruit_Sensor *Adafruit_LPS2X::getTemperatureSensor(void) {
     @param  pressure Sensor event object that will be populated with pressure
    data
     @param  temp Sensor event object that will be populated with temp data
-    @returns True
+    @returns True if the sensor was read, false on a bus error or timeout
 */
 /**************************************************************************/
 bool Adafruit_LPS2X::getEvent(sensors_event_t *pressure,
                               sensors_event_t *temp) {
-  uint32_t t = millis();
-  _read();
+  if (!_read()) {
+    return false;
+  }
+  sampleConsumers = LPS2X_CONSUMER_TEMP | LPS2X_CONSUMER_PRESSURE;
 
   // use helpers to fill in the events
-  fillPressureEvent(pressure, t);
-  fillTempEvent(temp, t);
+  fillPressureEvent(pressure, sampleMillis);
+  fillTempEvent(temp, sampleMillis);
   return true;
 }
 
+/*!
+    @brief  Clears arrays of events and fills in the fields that are the same
+   for every sample, ready for `getEvents`. Only needs calling once for
+   arrays that are reused
+    @param  pressures Array of pressure events, or NULL
+    @param  temps Array of temperature events, or NULL
+    @param  n The number of events in each array
+*/
+void Adafruit_LPS2X::initEvents(sensors_event_t *pressures,
+                                sensors_event_t *temps, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (pressures) {
+      initPressureEvent(&pressures[i]);
+    }
+    if (temps) {
+      initTempEvent(&temps[i]);
+    }
+  }
+}
+
+/*!
+    @brief  Fills arrays of events prepared by `initEvents` with the waiting
+   samples, writing only each event's value and timestamp. Samples come from
+   the ring when `enableSampleBuffer` is active, otherwise from one burst
+   read of the FIFO, or with the FIFO bypassed, from the output registers if
+   a new sample is ready. Nothing waits on the sensor
+    @param  pressures Array of pressure events, or NULL
+    @param  temps Array of temperature events, or NULL
+    @param  n The number of events each array can hold
+    @returns The number of events filled, oldest first
+*/
+size_t Adafruit_LPS2X::getEvents(sensors_event_t *pressures,
+                                 sensors_event_t *temps, size_t n) {
+  // sample times are kept in micros(), events carry millis()
+  uint32_t now_ms = millis();
+  uint32_t now_us = micros();
+  size_t count = 0;
+
+  if (ring) {
+    lps2x_raw_sample_t raw;
+    while (count < n && readBufferedSample(&raw)) {
+      uint32_t timestamp = now_ms - (now_us - raw.timestamp) / 1000;
+      if (pressures) {
+        pressures[count].timestamp = timestamp;
+        pressures[count].pressure = raw.pressure * (1.0f / 4096);
+      }
+      if (temps) {
+        temps[count].timestamp = timestamp;
+        temps[count].temperature =
+            (raw.temperature / temp_scaling) + temp_offset;
+      }
+      count++;
+    }
+    return count;
+  }
+
+  if (_fifoBypassed()) {
+    if (n == 0 || !_readDataIfReady()) {
+      return 0;
+    }
+    if (pressures) {
+      pressures[0].timestamp = sampleMillis;
+      pressures[0].pressure = _pressure;
+    }
+    if (temps) {
+      temps[0].timestamp = sampleMillis;
+      temps[0].temperature = _temp;
+    }
+    return 1;
+  }
+
+  uint8_t level;
+  if (!_readFifoLevel(&level)) {
+    return 0;
+  }
+  count = (level > n) ? n : level;
+  uint8_t buffer[LPS2X_FIFO_DEPTH * 5];
+  if (count == 0 || !_readRawRecords(buffer, count)) {
+    return 0;
+  }
+
+  // the newest sample in the FIFO is taken to be current, as in `readFifo`
+  for (size_t i = 0; i < count; i++) {
+    uint32_t timestamp =
+        now_ms - ((uint32_t)(level - 1 - i) * samplePeriod) / 1000;
+    float pressure, temperature;
+    _decode(buffer + (i * 5), &pressure, &temperature);
+    if (pressures) {
+      pressures[i].timestamp = timestamp;
+      pressures[i].pressure = pressure;
+    }
+    if (temps) {
+      temps[i].timestamp = timestamp;
+      temps[i].temperature = temperature;
+    }
+  }
+  return count;
+}
+
 void Adafruit_LPS2X::fillPressureEvent(sensors_event_t *pressure,
                                        uint32_t timestamp) {
+  initPressureEvent(pressure);
+  pressure->timestamp = timestamp;
+  pressure->pressure = _pressure;
+}
+
+void Adafruit_LPS2X::fillTempEvent(sensors_event_t *temp, uint32_t timestamp) {
+  initTempEvent(temp);
+  temp->timestamp = timestamp;
+  temp->temperature = _temp;
+}
+
+void Adafruit_LPS2X::initPressureEvent(sensors_event_t *pressure) {
   memset(pressure, 0, sizeof(sensors_event_t));
   pressure->version = sizeof(sensors_event_t);
   pressure->sensor_id = _sensorid_pressure;
   pressure->type = SENSOR_TYPE_PRESSURE;
-  pressure->timestamp = timestamp;
-  pressure->pressure = _pressure;
 }
 
-void Adafruit_LPS2X::fillTempEvent(sensors_event_t *temp, uint32_t timestamp) {
+void Adafruit_LPS2X::initTempEvent(sensors_event_t *temp) {
   memset(temp, 0, sizeof(sensors_event_t));
   temp->version = sizeof(sensors_event_t);
   temp->sensor_id = _sensorid_temp;
   temp->type = SENSOR_TYPE_AMBIENT_TEMPERATURE;
-  temp->timestamp = timestamp;
-  temp->temperature = _temp;
 }
 
 /**************************************************************************/
@@ -290,12 +1809,14 @@ void Adafruit_LPS2X_Pressure::getSensor(sensor_t *sensor) {
 /*!
     @brief  Gets the pressure as a standard sensor event
     @param  event Sensor event object that will be populated
-    @returns True
+    @returns True if the sensor was read, false on a bus error or timeout
 */
 /**************************************************************************/
 bool Adafruit_LPS2X_Pressure::getEvent(sensors_event_t *event) {
-  _theLPS2X->_read();
-  _theLPS2X->fillPressureEvent(event, millis());
+  if (!_theLPS2X->_readCached(LPS2X_CONSUMER_PRESSURE)) {
+    return false;
+  }
+  _theLPS2X->fillPressureEvent(event, _theLPS2X->sampleMillis);
 
   return true;
 }
@@ -326,12 +1847,14 @@ void Adafruit_LPS2X_Temp::getSensor(sensor_t *sensor) {
 /*!
     @brief  Gets the temperature as a standard sensor event
     @param  event Sensor event object that will be populated
-    @returns True
+    @returns True if the sensor was read, false on a bus error or timeout
 */
 /**************************************************************************/
 bool Adafruit_LPS2X_Temp::getEvent(sensors_event_t *event) {
-  _theLPS2X->_read();
-  _theLPS2X->fillTempEvent(event, millis());
+  if (!_theLPS2X->_readCached(LPS2X_CONSUMER_TEMP)) {
+    return false;
+  }
+  _theLPS2X->fillTempEvent(event, _theLPS2X->sampleMillis);
 
   return true;
 }
@@ -18,23 +18,41 @@
 #ifndef _ADAFRUIT_LPS2X_H
 #define _ADAFRUIT_LPS2X_H
 
+#ifdef ARDUINO
 #include "Arduino.h"
 #include <Adafruit_BusIO_Register.h>
 #include <Adafruit_I2CDevice.h>
+#include <Adafruit_SPIDevice.h>
 #include <Adafruit_Sensor.h>
 #include <Wire.h>
+#define LPS2X_HAS_BUSIO ///< `begin_I2C` and `begin_SPI` are available
+#else
+#include "Adafruit_LPS2X_Host.h"
+#endif
+
+#include "Adafruit_LPS2X_Transport.h"
 
 #define LPS2X_I2CADDR_DEFAULT 0x5D ///< LPS2X default i2c address
 #define LPS2X_WHOAMI 0x0F          ///< Chip ID register
-
-#define LPS22HB_CHIP_ID 0xB1   ///< LPS22 default device id from WHOAMI
-#define LPS22_THS_P_L_REG 0x0C ///< Pressure threshold value for int
-#define LPS22_CTRL_REG1 0x10   ///< First control register. Includes BD & ODR
-#define LPS22_CTRL_REG2 0x11   ///< Second control register. Includes SW Reset
+#define LPS2X_SPI_MAX_FREQ                                                     \
+  10000000 ///< Fastest SPI clock supported by both the LPS22HB and LPS25HB
+
+#define LPS22HB_CHIP_ID 0xB1     ///< LPS22 default device id from WHOAMI
+#define LPS22_INTERRUPT_CFG 0x0B ///< Interrupt and reference mode control
+#define LPS22_THS_P_L_REG 0x0C   ///< Pressure threshold value for int
+#define LPS22_CTRL_REG1 0x10     ///< First control register. Includes BD & ODR
+#define LPS22_CTRL_REG2 0x11     ///< Second control register. Includes SW Reset
 #define LPS22_CTRL_REG3                                                        \
   0x12 ///< Third control register. Includes interrupt polarity
+#define LPS22_FIFO_CTRL 0x14   ///< FIFO mode and watermark level
+#define LPS22_REF_P_XL 0x15    ///< Reference pressure, 3 bytes
+#define LPS22_RPDS_L 0x18      ///< Pressure offset, 2 bytes
+#define LPS22_RES_CONF 0x1A    ///< Low current mode selection
+#define LPS22_FIFO_STATUS 0x26 ///< FIFO watermark, overrun and fill level
 
 #define LPS25HB_CHIP_ID 0xBD ///< LPS25HB default device id from WHOAMI
+#define LPS25_REF_P_XL 0x08  ///< Reference pressure, 3 bytes
+#define LPS25_RES_CONF 0x10  ///< Pressure and temperature averaging
 #define LPS25_CTRL_REG1 0x20 ///< First control register. Includes BD & ODR
 #define LPS25_CTRL_REG2 0x21 ///< Second control register. Includes SW Reset
 #define LPS25_CTRL_REG3                                                        \
@@ -42,12 +60,30 @@
 #define LPS25_CTRL_REG4                                                        \
   0x23 ///< Fourth control register. Includes DRDY INT control
 #define LPS25_INTERRUPT_CFG 0x24 ///< Interrupt control register
-#define LPS25_THS_P_L_REG 0xB0   ///< Pressure threshold value for int
+#define LPS25_FIFO_CTRL 0x2E     ///< FIFO mode and watermark level
+#define LPS25_FIFO_STATUS 0x2F   ///< FIFO watermark, overrun and fill level
+#define LPS25_THS_P_L_REG 0x30   ///< Pressure threshold value for int
+#define LPS25_RPDS_L 0x39        ///< Pressure offset, 2 bytes
 
+#define LPS2X_STATUS 0x27 ///< Pressure and temperature data available flags
 #define LPS2X_PRESS_OUT_XL                                                     \
   (0x28 | 0x80) ///< | 0x80 to set auto increment on multi-byte read
 #define LPS2X_TEMP_OUT_L (0x2B | 0x80) ///< | 0x80 to set auto increment on
 
+#define LPS2X_FIFO_DEPTH 32 ///< Number of samples the hardware FIFO can hold
+
+#define LPS2X_INT_SOURCE 0x25    ///< Which threshold event fired
+#define LPS2X_INT_PRES_HIGH 0x01 ///< `getInterruptSource`: above threshold
+#define LPS2X_INT_PRES_LOW 0x02  ///< `getInterruptSource`: below threshold
+#define LPS2X_INT_ACTIVE 0x04    ///< `getInterruptSource`: an event is active
+
+#define LPS2X_TIMEOUT_MS 100 ///< Longest wait for a reset or conversion
+
+#define LPS2X_CALIBRATION_SIZE 16 ///< Bytes used by `saveCalibration`
+
+#define LPS2X_CONSUMER_TEMP 0x01     ///< Temp unified sensor, for caching
+#define LPS2X_CONSUMER_PRESSURE 0x02 ///< Pressure unified sensor, for caching
+
 /**
  * @brief
  *
@@ -75,6 +111,114 @@ typedef enum {
   LPS22_RATE_75_HZ,
 } lps22_rate_t;
 
+/**
+ * @brief
+ *
+ * Allowed values for `setFifoMode`.
+ */
+typedef enum {
+  LPS22_FIFO_BYPASS,
+  LPS22_FIFO_FIFO,
+  LPS22_FIFO_STREAM,
+  LPS22_FIFO_STREAM_TO_FIFO,
+  LPS22_FIFO_BYPASS_TO_STREAM,
+  LPS22_FIFO_DYNAMIC_STREAM = 6,
+  LPS22_FIFO_BYPASS_TO_FIFO,
+} lps22_fifo_mode_t;
+
+/**
+ * @brief
+ *
+ * Allowed values for `setFifoMode`.
+ */
+typedef enum {
+  LPS25_FIFO_BYPASS,
+  LPS25_FIFO_FIFO,
+  LPS25_FIFO_STREAM,
+  LPS25_FIFO_STREAM_TO_FIFO,
+  LPS25_FIFO_BYPASS_TO_STREAM,
+  LPS25_FIFO_MEAN = 6,
+  LPS25_FIFO_BYPASS_TO_FIFO,
+} lps25_fifo_mode_t;
+
+/**
+ * @brief
+ *
+ * Allowed values for `setFifoMeanSamples`.
+ */
+typedef enum {
+  LPS25_FIFO_MEAN_2 = 0x01,
+  LPS25_FIFO_MEAN_4 = 0x03,
+  LPS25_FIFO_MEAN_8 = 0x07,
+  LPS25_FIFO_MEAN_16 = 0x0F,
+  LPS25_FIFO_MEAN_32 = 0x1F,
+} lps25_fifo_mean_t;
+
+/**
+ * @brief
+ *
+ * Allowed values for `setPressureAveraging`.
+ */
+typedef enum {
+  LPS25_PRES_AVG_8,
+  LPS25_PRES_AVG_32,
+  LPS25_PRES_AVG_128,
+  LPS25_PRES_AVG_512,
+} lps25_pres_avg_t;
+
+/**
+ * @brief
+ *
+ * Allowed values for `setTemperatureAveraging`.
+ */
+typedef enum {
+  LPS25_TEMP_AVG_8,
+  LPS25_TEMP_AVG_16,
+  LPS25_TEMP_AVG_32,
+  LPS25_TEMP_AVG_64,
+} lps25_temp_avg_t;
+
+/**
+ * @brief
+ *
+ * Allowed values for `setReferenceMode`.
+ */
+typedef enum {
+  LPS2X_REFERENCE_FIXED,    ///< Thresholds relative to `setReferencePressure`
+  LPS2X_REFERENCE_AUTOZERO, ///< Capture REF_P, outputs become relative to it
+  LPS2X_REFERENCE_AUTORIFP, ///< Capture REF_P for thresholds only (LPS22)
+} lps2x_reference_mode_t;
+
+/** A register address paired with a copy of its contents, so bit fields can
+ * be updated without reading the register back first */
+typedef struct {
+  uint8_t address; ///< Register address
+  uint8_t value;   ///< Last value written to or read from the register
+} lps2x_shadow_reg_t;
+
+/** Bus traffic counters kept by the driver */
+typedef struct {
+  uint32_t transactions; ///< Number of bus transactions issued
+  uint32_t bytes;        ///< Bytes clocked on the bus, including address bytes
+  uint32_t failures;     ///< Transactions that failed after all retries
+  uint32_t retries;      ///< Transactions repeated after a failure
+  uint32_t timeouts;     ///< Waits on the sensor that gave up
+  uint32_t max_latency;  ///< Longest transaction including retries, in us
+} lps2x_bus_stats_t;
+
+/** A single pressure and temperature measurement */
+typedef struct {
+  float pressure;    ///< Pressure in hPa
+  float temperature; ///< Temperature in degrees C
+} lps2x_sample_t;
+
+/** A single measurement as raw sensor counts, tagged with when it was taken */
+typedef struct {
+  uint32_t timestamp;  ///< `micros()` at conversion, or read for `readRaw`
+  int32_t pressure;    ///< Raw 24-bit pressure, 4096 LSB/hPa
+  int16_t temperature; ///< Raw 16-bit temperature
+} lps2x_raw_sample_t;
+
 class Adafruit_LPS2X;
 
 /** Adafruit Unified Sensor interface for temperature component of LPS2X */
@@ -113,30 +257,153 @@ private:
 class Adafruit_LPS2X {
 public:
   Adafruit_LPS2X();
-  virtual ~Adafruit_LPS2X(){};
+  virtual ~Adafruit_LPS2X();
 
+#ifdef LPS2X_HAS_BUSIO
   bool begin_I2C(uint8_t i2c_addr = LPS2X_I2CADDR_DEFAULT,
                  TwoWire *wire = &Wire, int32_t sensor_id = 0);
 
   bool begin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI,
-                 int32_t sensor_id = 0);
+                 int32_t sensor_id = 0,
+                 uint32_t frequency = LPS2X_SPI_MAX_FREQ);
   bool begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
-                 int8_t mosi_pin, int32_t sensor_id = 0);
+                 int8_t mosi_pin, int32_t sensor_id = 0,
+                 uint32_t frequency = LPS2X_SPI_MAX_FREQ);
+#endif
+  bool begin_Transport(Adafruit_LPS2X_Transport *transport,
+                       int32_t sensor_id = 0);
 
   void setPresThreshold(uint16_t hPa_delta);
+  void setPresThresholdHPa(float hPa_delta);
+  void setReferencePressure(float hPa);
+  float getReferencePressure(void);
+  void configureThresholdInterrupt(bool pres_high, bool pres_low,
+                                   bool latch = false);
+  uint8_t getInterruptSource(void);
+
+  /** @brief Selects the reference threshold events are measured against
+      @param mode The reference mode. Must be a `lps2x_reference_mode_t`
+      @returns False if the chip does not support the mode */
+  virtual bool setReferenceMode(lps2x_reference_mode_t mode) = 0;
+
   bool getEvent(sensors_event_t *pressure, sensors_event_t *temp);
-  void reset(void);
+  void initEvents(sensors_event_t *pressures, sensors_event_t *temps,
+                  size_t n);
+  size_t getEvents(sensors_event_t *pressures, sensors_event_t *temps,
+                   size_t n);
+  bool reset(void);
+
+  bool startMeasurement(void);
+  bool isMeasurementReady(void);
+  bool readMeasurement(sensors_event_t *pressure, sensors_event_t *temp);
+  bool poll(sensors_event_t *pressure, sensors_event_t *temp);
+
+  uint8_t getFifoLevel(void);
+  uint8_t readFifo(lps2x_sample_t *samples, uint8_t max_samples,
+                   uint32_t *timestamps = NULL);
+  uint32_t getSampleTime(void);
+  uint32_t getSamplePeriod(void);
+
+  bool enableSampleBuffer(lps2x_raw_sample_t *buffer, uint8_t size,
+                          bool fifo_watermark = false);
+  void handleInterrupt(void);
+  uint8_t service(void);
+  uint8_t samplesAvailable(void);
+  uint32_t samplesDropped(void);
+  bool readBufferedSample(lps2x_raw_sample_t *sample);
+  void convertSample(const lps2x_raw_sample_t *raw, lps2x_sample_t *sample);
 
   Adafruit_Sensor *getTemperatureSensor(void);
   Adafruit_Sensor *getPressureSensor(void);
 
+  void setSampleCaching(bool enable);
+
+  bool setPressureOffset(float hPa);
+  float getPressureOffset(void);
+  bool calibrate(float reference_hPa, uint8_t samples = 16,
+                 bool temperature_point = false);
+  void setTemperatureCoefficient(float hPa_per_C);
+  float getTemperatureCoefficient(void);
+  bool updateTemperatureCompensation(void);
+  bool saveCalibration(uint8_t *buffer);
+  bool loadCalibration(const uint8_t *buffer);
+  void setFastInit(bool enable);
+  void setTemperatureDivider(uint8_t divider);
+
+  void getBusStats(lps2x_bus_stats_t *stats);
+  void resetBusStats(void);
+  void setBusRetries(uint8_t retries, uint16_t backoff_us = 100);
+
+  void setDutyCycle(uint32_t interval_ms);
+  bool updateDutyCycle(sensors_event_t *pressure, sensors_event_t *temp);
+  uint32_t getActiveTime(void);
+
+  bool readRaw(lps2x_raw_sample_t *sample);
+  bool readFixed(int32_t *pressure, int16_t *temp);
+  int32_t rawToPressureFixed(int32_t raw_pressure);
+  int16_t rawToTemperatureFixed(int16_t raw_temp);
+
 protected:
   /**! @brief The subclasses' hardware initialization function
      @param sensor_id The unique sensor id we want to assign it
      @returns True on success, false if something went wrong! **/
   virtual bool _init(int32_t sensor_id) = 0;
 
-  void _read(void);
+  /**! @brief Puts the subclass in one-shot mode for duty cycled sampling **/
+  virtual void _setupDutyCycle(void) = 0;
+  /**! @brief Wakes the sensor for or powers it down after a duty cycled
+     sample. The default does nothing, for chips that power down on their own
+     after a one-shot conversion
+     @param active True to wake the sensor, false to power it down
+     @returns True if the write succeeded **/
+  virtual bool _setDutyCyclePower(bool active) {
+    (void)active;
+    return true;
+  }
+  /**! @brief Enables or disables threshold interrupt generation
+     @param enable True to enable **/
+  virtual void _setThresholdEnable(bool enable) = 0;
+  /**! @brief Reads the number of unread samples in the FIFO
+     @param level Where to store the number of samples waiting, 0-32
+     @returns True if the read succeeded **/
+  virtual bool _readFifoLevel(uint8_t *level) = 0;
+
+  void _deleteBusDevices(void);
+
+  bool _busIsSPI(void);
+  bool _busRead(uint8_t addr, uint8_t *buffer, uint8_t len);
+  bool _busWrite(uint8_t addr, const uint8_t *buffer, uint8_t len);
+  bool _readRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  bool _readRegister(uint8_t reg, uint8_t *value);
+  bool _writeRegisters(uint8_t reg, const uint8_t *buffer, uint8_t len);
+  bool _writeRegister(uint8_t reg, uint8_t value);
+  bool _retry(uint8_t attempt);
+  void _endTransaction(uint32_t start, bool ok);
+  bool _writeBits(lps2x_shadow_reg_t *reg, uint8_t bits, uint8_t shift,
+                  uint8_t value);
+  uint8_t _readBits(const lps2x_shadow_reg_t *reg, uint8_t bits,
+                    uint8_t shift);
+  bool _loadShadowRegisters(void);
+  bool _prepareRegisters(void);
+  void _waitForFirstSample(void);
+
+  bool _read(void);
+  bool _pollReady(bool *ready);
+  bool _waitForMeasurement(void);
+  bool _waitForSample(void);
+  bool _readData(void);
+  bool _readDataIfReady(void);
+  bool _readCached(uint8_t consumer);
+  bool _skipTemperature(void);
+  bool _fifoBypassed(void);
+  void _storeSample(const uint8_t *buffer, bool pressure_only);
+  uint8_t _readSamples(lps2x_sample_t *samples, uint8_t count);
+  bool _readRawRecords(uint8_t *buffer, uint8_t count);
+  void _decode(const uint8_t *buffer, float *pressure, float *temp);
+  static void _decodeRaw(const uint8_t *buffer, int32_t *pressure,
+                         int16_t *temp);
+  static int32_t _decodeRawPressure(const uint8_t *buffer);
+  bool _pushSample(uint32_t timestamp, const uint8_t *buffer);
 
   float _temp,   ///< Last reading's temperature (C)
       _pressure; ///< Last reading's pressure (hPa)
@@ -145,21 +412,72 @@ protected:
       _sensorid_temp;          ///< ID number for temperature
   float temp_scaling = 1;      ///< Different chips have different scalings
   float temp_offset = 1;       ///< Different chips have different offsets
+  int32_t temp_scaling_fixed = 65536; ///< 6553600 / `temp_scaling`
+  int16_t temp_offset_fixed = 0;      ///< `temp_offset` * 100
   uint8_t inc_spi_flag =
       0; ///< If this chip has a bitflag for incrementing SPI registers
   bool isOneShot = false; ///< true if data rate is one-shot
-
+  bool measurementPending =
+      false;             ///< true if a one-shot conversion has been started
+  bool fastInit = false; ///< true to keep the running config in `begin_*`
+
+  uint32_t measurementStart = 0; ///< `millis()` at the last one-shot start
+
+  uint8_t pres_ready_flag = 0x01; ///< P_DA in STATUS
+  uint8_t tempDivider = 1;        ///< Samples per temperature read
+  uint8_t tempCountdown = 0;      ///< Pressure-only reads left until then
+
+  uint32_t dutyInterval = 0;   ///< ms between duty cycled samples, 0 if off
+  uint32_t dutyLastWake = 0;   ///< `millis()` at the last duty cycle wake
+  uint32_t dutyWakeMicros = 0; ///< `micros()` at the last duty cycle wake
+  uint32_t dutyActiveTime = 0; ///< us awake for the last duty cycled sample
+  bool dutyAwake = false;      ///< true while a duty cycled sample is taken
+
+  float calOffset = 0;       ///< Pressure error in hPa at `calTemperature`
+  float calTemperature = 0;  ///< Temperature in C when calibrated
+  float tempCoefficient = 0; ///< Pressure error change in hPa per C
+  int16_t rpdsValue = 0;     ///< Last offset written to RPDS, 16 LSB/hPa
+  bool rpdsForce = false;    ///< true to rewrite RPDS even if unchanged
+
+  bool sampleCaching = false;  ///< true if unified sensors share samples
+  uint8_t sampleConsumers = 0; ///< Unified sensors served the last sample
+  uint32_t sampleTime = 0;     ///< `micros()` when the last sample was read
+  uint32_t sampleMillis = 0;   ///< `millis()` when the last sample was read
+  uint32_t samplePeriod = 0;   ///< Output data period in us, 0 if one-shot
+
+#ifdef LPS2X_HAS_BUSIO
   Adafruit_I2CDevice *i2c_dev = NULL; ///< Pointer to I2C bus interface
   Adafruit_SPIDevice *spi_dev = NULL; ///< Pointer to SPI bus interface
-
-  Adafruit_LPS2X_Temp *temp_sensor = NULL; ///< Temp sensor data object
-  Adafruit_LPS2X_Pressure *pressure_sensor =
-      NULL; ///< Pressure sensor data object
-
-  Adafruit_BusIO_Register *ctrl1_reg = NULL;   ///< The first control register
-  Adafruit_BusIO_Register *ctrl2_reg = NULL;   ///< The second control register
-  Adafruit_BusIO_Register *ctrl3_reg = NULL;   ///< The third control register
-  Adafruit_BusIO_Register *threshp_reg = NULL; ///< Pressure threshold
+#endif
+  Adafruit_LPS2X_Transport *transport = NULL; ///< Custom bus, not owned
+
+  Adafruit_LPS2X_Temp temp_sensor;         ///< Temp sensor data object
+  Adafruit_LPS2X_Pressure pressure_sensor; ///< Pressure sensor data object
+
+  lps2x_shadow_reg_t ctrl1_reg = {0, 0};     ///< The first control register
+  lps2x_shadow_reg_t ctrl2_reg = {0, 0};     ///< The second control register
+  lps2x_shadow_reg_t ctrl3_reg = {0, 0};     ///< The third control register
+  lps2x_shadow_reg_t ctrl4_reg = {0, 0};     ///< Data interrupts, LPS25 only
+  lps2x_shadow_reg_t fifo_ctrl_reg = {0, 0}; ///< FIFO mode and watermark
+  lps2x_shadow_reg_t res_conf_reg = {0, 0};  ///< Resolution configuration
+  lps2x_shadow_reg_t int_cfg_reg = {0, 0};   ///< Threshold interrupt control
+  uint8_t threshp_reg = 0;                   ///< Pressure threshold address
+  uint8_t refp_reg = 0;                      ///< Reference pressure address
+  uint8_t rpds_reg = 0;                      ///< Pressure offset address
+
+  lps2x_bus_stats_t bus_stats = {0, 0, 0, 0, 0, 0}; ///< Bus traffic counters
+
+  uint8_t busRetries = 0;  ///< Retries after a failed bus transaction
+  uint16_t busBackoff = 0; ///< us before the first retry, doubling after
+
+  lps2x_raw_sample_t *ring = NULL;     ///< Interrupt driven sample storage
+  uint8_t ring_mask = 0;               ///< Ring capacity minus one
+  uint8_t ring_head = 0;               ///< Next slot written by `service`
+  uint8_t ring_tail = 0;               ///< Next slot read by the consumer
+  uint32_t ring_dropped = 0;           ///< Samples lost to a full ring
+  bool ring_from_fifo = false;         ///< Interrupts are FIFO watermarks
+  volatile bool irq_pending = false;   ///< Set by `handleInterrupt`
+  volatile uint32_t irq_timestamp = 0; ///< `micros()` at the last interrupt
 
 private:
   friend class Adafruit_LPS2X_Temp;     ///< Gives access to private members to
@@ -167,29 +485,53 @@ private:
   friend class Adafruit_LPS2X_Pressure; ///< Gives access to private
                                         ///< members to Pressure data
                                         ///< object
+  friend class Adafruit_LPS2X_Group;    ///< Gives access to private
+                                        ///< members to sensor groups
+
+  friend class Adafruit_LPS2X_LinuxI2CBatch; ///< Gives access to private
+                                             ///< members to batched reads
 
   void fillPressureEvent(sensors_event_t *pressure, uint32_t timestamp);
   void fillTempEvent(sensors_event_t *temp, uint32_t timestamp);
+  void initPressureEvent(sensors_event_t *pressure);
+  void initTempEvent(sensors_event_t *temp);
 };
 
 /** Specific subclass for LPS25 variant */
 class Adafruit_LPS25 : public Adafruit_LPS2X {
 public:
-  ~Adafruit_LPS25();
   lps25_rate_t getDataRate(void);
   void setDataRate(lps25_rate_t data_rate);
   void powerDown(bool power_down);
   void configureInterrupt(bool activelow, bool opendrain,
                           bool pres_high = false, bool pres_low = false);
+  void configureDataInterrupt(bool data_ready, bool fifo_overrun = false,
+                              bool fifo_watermark = false,
+                              bool fifo_empty = false);
+
+  void setPressureAveraging(lps25_pres_avg_t samples);
+  lps25_pres_avg_t getPressureAveraging(void);
+  void setTemperatureAveraging(lps25_temp_avg_t samples);
+  lps25_temp_avg_t getTemperatureAveraging(void);
+
+  void setFifoMode(lps25_fifo_mode_t mode);
+  lps25_fifo_mode_t getFifoMode(void);
+  void setFifoWatermark(uint8_t level, bool stop_on_watermark = false);
+  void setFifoMeanSamples(lps25_fifo_mean_t samples);
+
+  bool setReferenceMode(lps2x_reference_mode_t mode);
 
 protected:
   bool _init(int32_t sensor_id);
+  void _setupDutyCycle(void);
+  bool _setDutyCyclePower(bool active);
+  void _setThresholdEnable(bool enable);
+  bool _readFifoLevel(uint8_t *level);
 };
 
 /** Specific subclass for LPS22 variant */
 class Adafruit_LPS22 : public Adafruit_LPS2X {
 public:
-  ~Adafruit_LPS22();
   lps22_rate_t getDataRate(void);
   void setDataRate(lps22_rate_t data_rate);
   void configureInterrupt(bool activelow, bool opendrain, bool data_ready,
@@ -197,8 +539,19 @@ public:
                           bool fifo_full = false, bool fifo_watermark = false,
                           bool fifo_overflow = false);
 
+  void setFifoMode(lps22_fifo_mode_t mode);
+  lps22_fifo_mode_t getFifoMode(void);
+  void setFifoWatermark(uint8_t level, bool stop_on_watermark = false);
+
+  void setLowCurrent(bool low_current);
+
+  bool setReferenceMode(lps2x_reference_mode_t mode);
+
 protected:
   bool _init(int32_t sensor_id);
+  void _setupDutyCycle(void);
+  void _setThresholdEnable(bool enable);
+  bool _readFifoLevel(uint8_t *level);
 };
 
 #endif
@@ -0,0 +1,176 @@
+/*!
+ *  @file Adafruit_LPS2X_Altitude.cpp
+ *
+ * 	Streaming altitude and vertical speed estimation for LPS2X sensors
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_LPS2X_Altitude.h"
+#include <math.h>
+
+// The barometric formula h = 44330.77 * (1 - (p / p0) ^ 0.190263) is replaced
+// by a degree 7 Chebyshev fit over p / p0 = 0.45 to 1.1, about -770 m to
+// 6300 m. The fit's input is u = (p / p0 - 0.775) / 0.325 and its largest
+// error over that range is about 1 cm, well below the sensors' noise
+static const float alt_poly_mid = 0.775f / 0.325f;
+static const float alt_poly[] = {2098.58558f,  -3369.60663f, 572.292823f,
+                                 -144.796659f, 41.7107959f,  -13.2843893f,
+                                 5.96924432f,  -2.1024858f};
+
+/**
+ * @brief Construct a new altitude estimator
+ *
+ * @param sea_level_hPa The pressure at altitude 0
+ */
+Adafruit_LPS2X_Altitude::Adafruit_LPS2X_Altitude(float sea_level_hPa) {
+  setSeaLevelPressure(sea_level_hPa);
+  setFilterGains(0.2f, 0.02f);
+}
+
+/**
+ * @brief Sets the pressure at altitude 0, e.g. the local QNH or a pressure
+ * measured at the ground
+ *
+ * @param hPa The reference pressure in hPa
+ */
+void Adafruit_LPS2X_Altitude::setSeaLevelPressure(float hPa) {
+  _seaLevel = hPa;
+  _polyScale = 1.0f / (hPa * 0.325f);
+  _polyScaleRaw = _polyScale * (1.0f / 4096);
+}
+
+/**
+ * @brief Sets the alpha-beta filter gains. Higher gains follow changes faster
+ * but pass through more sensor noise. beta = alpha^2 / (2 - alpha) gives a
+ * critically damped response
+ *
+ * @param alpha Altitude correction gain, 0 to 1
+ * @param beta Vertical speed correction gain, 0 to 1
+ */
+void Adafruit_LPS2X_Altitude::setFilterGains(float alpha, float beta) {
+  _alpha = alpha;
+  _beta = beta;
+  _lastDt = 0; // recompute `_betaPerDt`
+}
+
+/**
+ * @brief Forgets the filter state, so the next sample restarts it
+ */
+void Adafruit_LPS2X_Altitude::reset(void) {
+  _started = false;
+  _altitude = 0;
+  _speed = 0;
+}
+
+/**
+ * @brief Adds a pressure sample
+ *
+ * @param pressure The pressure in hPa
+ * @param timestamp When the sample was taken, in `micros()`
+ */
+void Adafruit_LPS2X_Altitude::update(float pressure, uint32_t timestamp) {
+  _filter(_altitudeFromRatio(pressure * _polyScale - alt_poly_mid), timestamp);
+}
+
+/**
+ * @brief Adds a sample from `Adafruit_LPS2X::readBufferedSample`, using its
+ * raw pressure directly
+ *
+ * @param sample The raw sample
+ */
+void Adafruit_LPS2X_Altitude::update(const lps2x_raw_sample_t *sample) {
+  float u = sample->pressure * _polyScaleRaw - alt_poly_mid;
+  _filter(_altitudeFromRatio(u), sample->timestamp);
+}
+
+/**
+ * @brief Adds a sample from `Adafruit_LPS2X::getEvent`. Event timestamps
+ * only have millisecond resolution, so prefer the other overloads at high
+ * data rates
+ *
+ * @param pressure The pressure event
+ */
+void Adafruit_LPS2X_Altitude::update(const sensors_event_t *pressure) {
+  // unsigned, so the product wraps like `micros()` rather than overflowing
+  update(pressure->pressure, (uint32_t)pressure->timestamp * 1000u);
+}
+
+/**
+ * @brief Converts a pressure to an altitude, without any filtering
+ *
+ * @param pressure The pressure in hPa
+ * @return float The altitude in m above the sea level pressure
+ */
+float Adafruit_LPS2X_Altitude::pressureToAltitude(float pressure) {
+  return _altitudeFromRatio(pressure * _polyScale - alt_poly_mid);
+}
+
+/**
+ * @brief Gets the filtered altitude
+ *
+ * @return float The altitude in m above the sea level pressure
+ */
+float Adafruit_LPS2X_Altitude::getAltitude(void) { return _altitude; }
+
+/**
+ * @brief Gets the filtered vertical speed
+ *
+ * @return float The vertical speed in m/s, positive when climbing
+ */
+float Adafruit_LPS2X_Altitude::getVerticalSpeed(void) { return _speed; }
+
+/**
+ * @brief Evaluates the altitude polynomial, falling back to the barometric
+ * formula outside the fitted range
+ *
+ * @param u The polynomial input, (p / p0 - 0.775) / 0.325
+ * @return float The altitude in m
+ */
+float Adafruit_LPS2X_Altitude::_altitudeFromRatio(float u) {
+  if (u < -1.0f || u > 1.0f) {
+    return 44330.77f * (1.0f - powf(u * 0.325f + 0.775f, 0.190263f));
+  }
+
+  float altitude = alt_poly[7];
+  for (int8_t i = 6; i >= 0; i--) {
+    altitude = altitude * u + alt_poly[i];
+  }
+  return altitude;
+}
+
+/**
+ * @brief Runs one step of the alpha-beta filter
+ *
+ * @param altitude The measured altitude in m
+ * @param timestamp When it was measured, in `micros()`
+ */
+void Adafruit_LPS2X_Altitude::_filter(float altitude, uint32_t timestamp) {
+  if (!_started) {
+    _altitude = altitude;
+    _speed = 0;
+    _lastTime = timestamp;
+    _started = true;
+    return;
+  }
+
+  uint32_t dt = timestamp - _lastTime;
+  if (dt == 0) {
+    return; // a repeated sample
+  }
+  _lastTime = timestamp;
+  if (dt != _lastDt) {
+    // samples usually arrive at a fixed data rate, so this is rarely redone
+    _lastDt = dt;
+    _betaPerDt = _beta * 1000000.0f / dt;
+  }
+
+  float predicted = _altitude + _speed * (dt * 1e-6f);
+  float residual = altitude - predicted;
+  _altitude = predicted + _alpha * residual;
+  _speed += _betaPerDt * residual;
+}
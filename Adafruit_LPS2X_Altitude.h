@@ -0,0 +1,62 @@
+/*!
+ *  @file Adafruit_LPS2X_Altitude.h
+ *
+ * 	Streaming altitude and vertical speed estimation for LPS2X sensors
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_ALTITUDE_H
+#define _ADAFRUIT_LPS2X_ALTITUDE_H
+
+#include "Adafruit_LPS2X.h"
+
+#define LPS2X_SEA_LEVEL_HPA 1013.25f ///< Standard sea level pressure
+
+/*!
+ *    @brief  Turns a stream of pressure samples into filtered altitude and
+ *            vertical speed. Each update costs a polynomial evaluation and a
+ *            few multiply-adds, with no `pow` or per-sample division
+ */
+class Adafruit_LPS2X_Altitude {
+public:
+  Adafruit_LPS2X_Altitude(float sea_level_hPa = LPS2X_SEA_LEVEL_HPA);
+
+  void setSeaLevelPressure(float hPa);
+  void setFilterGains(float alpha, float beta);
+  void reset(void);
+
+  void update(float pressure, uint32_t timestamp);
+  void update(const lps2x_raw_sample_t *sample);
+  void update(const sensors_event_t *pressure);
+
+  float pressureToAltitude(float pressure);
+  float getAltitude(void);
+  float getVerticalSpeed(void);
+
+private:
+  float _altitudeFromRatio(float u);
+  void _filter(float altitude, uint32_t timestamp);
+
+  float _seaLevel;     // reference pressure in hPa
+  float _polyScale;    // maps hPa to the polynomial's [-1, 1] input
+  float _polyScaleRaw; // the same for raw counts
+  float _alpha, _beta; // alpha-beta filter gains
+
+  float _altitude = 0; // filtered altitude in m
+  float _speed = 0;    // filtered vertical speed in m/s
+  bool _started = false;
+  uint32_t _lastTime = 0; // us
+  uint32_t _lastDt = 0;   // us, to reuse `_betaPerDt` at a fixed rate
+  float _betaPerDt = 0;   // `_beta` / dt in 1/s
+};
+
+#endif
@@ -0,0 +1,180 @@
+/*!
+ *  @file Adafruit_LPS2X_Decode.cpp
+ *
+ * 	Batch conversion of raw LPS2X output records. Plain C++ with no
+ * 	Arduino dependency, so it also builds for host tools
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_LPS2X_Decode.h"
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LPS2X_DECODE_WORDS ///< Unpack records from little endian words
+#endif
+
+/*!
+ *     @brief  Converts the records `start` to `count` - 1 one at a time
+ *     @param  records The raw records, `LPS2X_RECORD_SIZE` bytes each
+ *     @param  start The first record to convert
+ *     @param  count The number of records
+ *     @param  temp_scale Temperature in C per LSB
+ *     @param  temp_offset Temperature in C at raw 0
+ *     @param  pressure Array to hold the pressures in hPa
+ *     @param  temperature Array to hold the temperatures in C
+ */
+static void lps2x_decode_range(const uint8_t *records, size_t start,
+                               size_t count, float temp_scale,
+                               float temp_offset, float *pressure,
+                               float *temperature) {
+  for (size_t i = start; i < count; i++) {
+    const uint8_t *r = records + i * LPS2X_RECORD_SIZE;
+    // assemble PRESS_OUT in the top 24 bits so the arithmetic shift sign
+    // extends it
+    int32_t raw_pressure =
+        (int32_t)((uint32_t)r[0] << 8 | (uint32_t)r[1] << 16 |
+                  (uint32_t)r[2] << 24) >>
+        8;
+    int16_t raw_temp = (int16_t)((uint16_t)r[4] << 8 | r[3]);
+
+    pressure[i] = raw_pressure * (1.0f / 4096);
+    temperature[i] = raw_temp * temp_scale + temp_offset;
+  }
+}
+
+#ifdef LPS2X_DECODE_WORDS
+/*!
+ *     @brief  Sign extends a 24 bit value
+ *     @param  value The value in the low 24 bits
+ *     @returns The signed value
+ */
+static inline int32_t lps2x_sign_extend_24(uint32_t value) {
+  return (int32_t)(value << 8) >> 8;
+}
+
+/*!
+ *     @brief  Converts records four at a time. Four records are exactly five
+ *             little endian words, and unpacking those with shifts is
+ *             straight line code that compilers vectorize, unlike a stride
+ *             of five bytes
+ *     @param  records The raw records, `LPS2X_RECORD_SIZE` bytes each
+ *     @param  start The first record to convert
+ *     @param  count The number of records
+ *     @param  temp_scale Temperature in C per LSB
+ *     @param  temp_offset Temperature in C at raw 0
+ *     @param  pressure Array to hold the pressures in hPa
+ *     @param  temperature Array to hold the temperatures in C
+ *     @returns The index of the first record left unconverted
+ */
+static size_t lps2x_decode_words(const uint8_t *__restrict records,
+                                 size_t start, size_t count, float temp_scale,
+                                 float temp_offset, float *__restrict pressure,
+                                 float *__restrict temperature) {
+  size_t i = start;
+  for (; i + 4 <= count; i += 4) {
+    uint32_t w[5];
+    memcpy(w, records + i * LPS2X_RECORD_SIZE, sizeof(w));
+
+    int32_t raw_pressure[4] = {lps2x_sign_extend_24(w[0]),
+                               lps2x_sign_extend_24(w[1] >> 8),
+                               lps2x_sign_extend_24(w[2] >> 16 | w[3] << 16),
+                               lps2x_sign_extend_24(w[3] >> 24 | w[4] << 8)};
+    int16_t raw_temp[4] = {(int16_t)(w[0] >> 24 | w[1] << 8), (int16_t)w[2],
+                           (int16_t)(w[3] >> 8), (int16_t)(w[4] >> 16)};
+
+    for (uint8_t k = 0; k < 4; k++) {
+      pressure[i + k] = raw_pressure[k] * (1.0f / 4096);
+      temperature[i + k] = raw_temp[k] * temp_scale + temp_offset;
+    }
+  }
+  return i;
+}
+#endif
+
+/*!
+ *     @brief  Converts raw PRESS_OUT_XL..TEMP_OUT_H records, as read from the
+ *             FIFO or logged by the driver, to separate arrays of pressure
+ *             and temperature. Uses SSSE3 byte shuffles where available,
+ *             and otherwise unpacks four records from five words, which
+ *             compilers vectorize on other SIMD hosts
+ *     @param  records The raw records, `LPS2X_RECORD_SIZE` bytes each
+ *     @param  count The number of records
+ *     @param  temp_scale Temperature in C per LSB, e.g. `LPS22_TEMP_SCALE`
+ *     @param  temp_offset Temperature in C at raw 0, e.g. `LPS22_TEMP_OFFSET`
+ *     @param  pressure Array of `count` floats to hold the pressures in hPa
+ *     @param  temperature Array of `count` floats to hold the temperatures in
+ *             C
+ */
+void lps2x_decode_records(const uint8_t *records, size_t count,
+                          float temp_scale, float temp_offset,
+                          float *pressure, float *temperature) {
+  size_t i = 0;
+
+#if defined(__SSSE3__)
+  // four records are 20 bytes, covered by loads at +0 and +4. Each 32 bit
+  // lane gets the pressure in its top 24 bits or the temperature in its top
+  // 16, and arithmetic shifts sign extend them. -1 shuffles in a zero
+  const __m128i press_lo =
+      _mm_setr_epi8(-1, 0, 1, 2, -1, 5, 6, 7, -1, 10, 11, 12, -1, -1, -1, -1);
+  const __m128i press_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                         -1, -1, -1, -1, 11, 12, 13);
+  const __m128i temp_lo = _mm_setr_epi8(-1, -1, 3, 4, -1, -1, 8, 9, -1, -1,
+                                        13, 14, -1, -1, -1, -1);
+  const __m128i temp_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                        -1, -1, -1, -1, -1, 14, 15);
+  const __m128 press_scale = _mm_set1_ps(1.0f / 4096);
+  const __m128 t_scale = _mm_set1_ps(temp_scale);
+  const __m128 t_offset = _mm_set1_ps(temp_offset);
+
+  for (; i + 4 <= count; i += 4) {
+    const uint8_t *r = records + i * LPS2X_RECORD_SIZE;
+    __m128i lo = _mm_loadu_si128((const __m128i *)r);
+    __m128i hi = _mm_loadu_si128((const __m128i *)(r + 4));
+
+    __m128i p = _mm_or_si128(_mm_shuffle_epi8(lo, press_lo),
+                             _mm_shuffle_epi8(hi, press_hi));
+    __m128i t = _mm_or_si128(_mm_shuffle_epi8(lo, temp_lo),
+                             _mm_shuffle_epi8(hi, temp_hi));
+    p = _mm_srai_epi32(p, 8);
+    t = _mm_srai_epi32(t, 16);
+
+    // multiply then add, rather than fused, to match the portable loops
+    __m128 temp = _mm_mul_ps(_mm_cvtepi32_ps(t), t_scale);
+    _mm_storeu_ps(pressure + i, _mm_mul_ps(_mm_cvtepi32_ps(p), press_scale));
+    _mm_storeu_ps(temperature + i, _mm_add_ps(temp, t_offset));
+  }
+#elif defined(LPS2X_DECODE_WORDS)
+  i = lps2x_decode_words(records, i, count, temp_scale, temp_offset, pressure,
+                         temperature);
+#endif
+
+  lps2x_decode_range(records, i, count, temp_scale, temp_offset, pressure,
+                     temperature);
+}
+
+/*!
+ *     @brief  Converts raw records one at a time with the batch path's
+ *             arithmetic, e.g. to check or benchmark it against. The driver
+ *             divides by whole LSB per degree instead of multiplying by
+ *             `temp_scale`, so its temperatures can differ in the last bit
+ *     @param  records The raw records, `LPS2X_RECORD_SIZE` bytes each
+ *     @param  count The number of records
+ *     @param  temp_scale Temperature in C per LSB
+ *     @param  temp_offset Temperature in C at raw 0
+ *     @param  pressure Array of `count` floats to hold the pressures in hPa
+ *     @param  temperature Array of `count` floats to hold the temperatures in
+ *             C
+ */
+void lps2x_decode_records_scalar(const uint8_t *records, size_t count,
+                                 float temp_scale, float temp_offset,
+                                 float *pressure, float *temperature) {
+  lps2x_decode_range(records, 0, count, temp_scale, temp_offset, pressure,
+                     temperature);
+}
@@ -0,0 +1,41 @@
+/*!
+ *  @file Adafruit_LPS2X_Decode.h
+ *
+ * 	Batch conversion of raw LPS2X output records, for post-processing
+ * 	captured data on a host
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_DECODE_H
+#define _ADAFRUIT_LPS2X_DECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LPS2X_RECORD_SIZE 5 ///< Bytes in a PRESS_OUT_XL..TEMP_OUT_H record
+
+#define LPS22_TEMP_LSB_PER_C 100 ///< LPS22 temperature sensitivity
+#define LPS25_TEMP_LSB_PER_C 480 ///< LPS25 temperature sensitivity
+
+#define LPS22_TEMP_SCALE (1.0f / LPS22_TEMP_LSB_PER_C) ///< LPS22, C per LSB
+#define LPS22_TEMP_OFFSET 0.0f                         ///< LPS22, C at raw 0
+#define LPS25_TEMP_SCALE (1.0f / LPS25_TEMP_LSB_PER_C) ///< LPS25, C per LSB
+#define LPS25_TEMP_OFFSET 42.5f                        ///< LPS25, C at raw 0
+
+void lps2x_decode_records(const uint8_t *records, size_t count,
+                          float temp_scale, float temp_offset,
+                          float *pressure, float *temperature);
+void lps2x_decode_records_scalar(const uint8_t *records, size_t count,
+                                 float temp_scale, float temp_offset,
+                                 float *pressure, float *temperature);
+
+#endif
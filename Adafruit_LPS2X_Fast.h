@@ -0,0 +1,236 @@
+/*!
+ *  @file Adafruit_LPS2X_Fast.h
+ *
+ * 	Compile time specialized LPS2X driver for flash and cycle constrained
+ * 	builds
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_FAST_H
+#define _ADAFRUIT_LPS2X_FAST_H
+
+#include "Adafruit_LPS2X.h"
+#include "Adafruit_LPS2X_Decode.h"
+
+/** Register map and scaling of the LPS22HB */
+struct LPS2X_Chip22 {
+  typedef lps22_rate_t rate_t;                             ///< Data rates
+  static constexpr uint8_t chip_id = LPS22HB_CHIP_ID;      ///< WHOAMI value
+  static constexpr uint8_t ctrl1 = LPS22_CTRL_REG1;        ///< CTRL_REG1
+  static constexpr uint8_t ctrl2 = LPS22_CTRL_REG2;        ///< CTRL_REG2
+  static constexpr uint8_t ctrl2_default = 0x10;           ///< IF_ADD_INC
+  static constexpr uint8_t ctrl1_enable = 0x00;            ///< Always on
+  static constexpr uint8_t inc_spi_flag = 0x00;            ///< IF_ADD_INC
+  static constexpr uint8_t status_ready = 0x03;            ///< P_DA | T_DA
+  static constexpr float temp_scale = LPS22_TEMP_SCALE;    ///< C per LSB
+  static constexpr float temp_offset = LPS22_TEMP_OFFSET;  ///< C at raw 0
+  static constexpr rate_t default_rate = LPS22_RATE_25_HZ; ///< `begin` rate
+};
+
+/** Register map and scaling of the LPS25HB */
+struct LPS2X_Chip25 {
+  typedef lps25_rate_t rate_t;                             ///< Data rates
+  static constexpr uint8_t chip_id = LPS25HB_CHIP_ID;      ///< WHOAMI value
+  static constexpr uint8_t ctrl1 = LPS25_CTRL_REG1;        ///< CTRL_REG1
+  static constexpr uint8_t ctrl2 = LPS25_CTRL_REG2;        ///< CTRL_REG2
+  static constexpr uint8_t ctrl2_default = 0x00;           ///< Reset value
+  static constexpr uint8_t ctrl1_enable = 0x80;            ///< PD, powered up
+  static constexpr uint8_t inc_spi_flag = 0x40;            ///< MS bit
+  static constexpr uint8_t status_ready = 0x03;            ///< T_DA | P_DA
+  static constexpr float temp_scale = LPS25_TEMP_SCALE;    ///< C per LSB
+  static constexpr float temp_offset = LPS25_TEMP_OFFSET;  ///< C at raw 0
+  static constexpr rate_t default_rate = LPS25_RATE_25_HZ; ///< `begin` rate
+};
+
+/** I2C access through an `Adafruit_I2CDevice` */
+struct LPS2X_BusI2C {
+  typedef Adafruit_I2CDevice device_t; ///< The BusIO device type
+
+  /** @brief Reads consecutive registers in one transaction
+      @param dev The bus device
+      @param reg The first register address
+      @param inc_spi_flag Unused on I2C
+      @param buffer Where to store the register contents
+      @param len The number of registers to read
+      @returns True if the read succeeded */
+  static inline bool read(device_t *dev, uint8_t reg, uint8_t inc_spi_flag,
+                          uint8_t *buffer, uint8_t len) {
+    (void)inc_spi_flag;
+    uint8_t addr = (len > 1) ? (reg | 0x80) : reg; // auto increment
+    return dev->write_then_read(&addr, 1, buffer, len);
+  }
+
+  /** @brief Writes a single register
+      @param dev The bus device
+      @param reg The register address
+      @param value The value to write
+      @returns True if the write succeeded */
+  static inline bool write(device_t *dev, uint8_t reg, uint8_t value) {
+    return dev->write(&value, 1, true, &reg, 1);
+  }
+};
+
+/** SPI access through an `Adafruit_SPIDevice` */
+struct LPS2X_BusSPI {
+  typedef Adafruit_SPIDevice device_t; ///< The BusIO device type
+
+  /** @brief Reads consecutive registers in one transaction
+      @param dev The bus device
+      @param reg The first register address
+      @param inc_spi_flag The chip's SPI auto increment bit
+      @param buffer Where to store the register contents
+      @param len The number of registers to read
+      @returns True if the read succeeded */
+  static inline bool read(device_t *dev, uint8_t reg, uint8_t inc_spi_flag,
+                          uint8_t *buffer, uint8_t len) {
+    uint8_t addr = reg | 0x80 | ((len > 1) ? inc_spi_flag : 0);
+    return dev->write_then_read(&addr, 1, buffer, len);
+  }
+
+  /** @brief Writes a single register
+      @param dev The bus device
+      @param reg The register address
+      @param value The value to write
+      @returns True if the write succeeded */
+  static inline bool write(device_t *dev, uint8_t reg, uint8_t value) {
+    return dev->write(&value, 1, &reg, 1);
+  }
+};
+
+/*!
+ *    @brief  Minimal LPS2X driver with the chip and bus fixed at compile
+ *            time. Register addresses, scaling and bus access are constants,
+ *            so reads inline down to one BusIO call and a few multiply-adds,
+ *            with no virtual calls, heap allocation or bus checks.
+ *            For example `Adafruit_LPS2X_Fast<LPS2X_Chip22, LPS2X_BusI2C>
+ *            lps(LPS2X_I2CADDR_DEFAULT, &Wire)` or
+ *            `Adafruit_LPS2X_Fast<LPS2X_Chip25, LPS2X_BusSPI> lps(cs_pin,
+ *            LPS2X_SPI_MAX_FREQ)`
+ *    @tparam Chip `LPS2X_Chip22` or `LPS2X_Chip25`
+ *    @tparam Bus `LPS2X_BusI2C` or `LPS2X_BusSPI`
+ */
+template <class Chip, class Bus> class Adafruit_LPS2X_Fast {
+public:
+  /** @brief Creates the driver and its bus device
+      @param args The arguments for the BusIO device's constructor */
+  template <typename... Args>
+  Adafruit_LPS2X_Fast(Args... args) : _dev(args...) {}
+
+  /** @brief Checks the chip ID, resets the chip and starts continuous
+      measurements at the library's default data rate
+      @returns True if the chip was found, reset within `LPS2X_TIMEOUT_MS`
+      and configured */
+  bool begin(void) {
+    uint8_t id = 0;
+    if (!_dev.begin() || !Bus::read(&_dev, LPS2X_WHOAMI, 0, &id, 1) ||
+        id != Chip::chip_id) {
+      return false;
+    }
+    if (!Bus::write(&_dev, Chip::ctrl2, Chip::ctrl2_default | 0x04)) {
+      return false; // SWRESET
+    }
+    uint32_t start = millis();
+    uint8_t ctrl2;
+    while (true) {
+      if (!Bus::read(&_dev, Chip::ctrl2, 0, &ctrl2, 1)) {
+        return false;
+      }
+      if (!(ctrl2 & 0x04)) {
+        break;
+      }
+      if ((millis() - start) >= LPS2X_TIMEOUT_MS) {
+        return false;
+      }
+      delay(1);
+    }
+    return setDataRate(Chip::default_rate);
+  }
+
+  /** @brief Sets the data rate, powering the chip up if needed
+      @param data_rate The data rate to set. Must be a `Chip::rate_t`
+      @returns True if the write succeeded */
+  bool setDataRate(typename Chip::rate_t data_rate) {
+    return Bus::write(&_dev, Chip::ctrl1,
+                      Chip::ctrl1_enable | ((uint8_t)data_rate << 4));
+  }
+
+  /** @brief Starts a one-shot conversion, when the data rate is one-shot
+      @returns True if the write succeeded */
+  bool startMeasurement(void) {
+    return Bus::write(&_dev, Chip::ctrl2, Chip::ctrl2_default | 0x01);
+  }
+
+  /** @brief Reads the latest sample as raw counts in one burst
+      @param pressure Raw 24-bit pressure, 4096 LSB/hPa
+      @param temp Raw 16-bit temperature
+      @returns True if the read succeeded */
+  bool readRaw(int32_t *pressure, int16_t *temp) {
+    uint8_t buffer[5];
+    if (!Bus::read(&_dev, LPS2X_PRESS_OUT_XL & 0x7F, Chip::inc_spi_flag,
+                   buffer, 5)) {
+      return false;
+    }
+    _decodeRaw(buffer, pressure, temp);
+    return true;
+  }
+
+  /** @brief Reads the latest sample in one burst
+      @param pressure The pressure in hPa
+      @param temp The temperature in C
+      @returns True if the read succeeded */
+  bool read(float *pressure, float *temp) {
+    int32_t raw_pressure;
+    int16_t raw_temp;
+    if (!readRaw(&raw_pressure, &raw_temp)) {
+      return false;
+    }
+    _convert(raw_pressure, raw_temp, pressure, temp);
+    return true;
+  }
+
+  /** @brief Reads STATUS and the output registers in one burst, keeping the
+      sample only if it is new
+      @param pressure The pressure in hPa
+      @param temp The temperature in C
+      @returns True if a new sample was read */
+  bool poll(float *pressure, float *temp) {
+    uint8_t buffer[6];
+    if (!Bus::read(&_dev, LPS2X_STATUS, Chip::inc_spi_flag, buffer, 6) ||
+        (buffer[0] & Chip::status_ready) != Chip::status_ready) {
+      return false;
+    }
+    int32_t raw_pressure;
+    int16_t raw_temp;
+    _decodeRaw(buffer + 1, &raw_pressure, &raw_temp);
+    _convert(raw_pressure, raw_temp, pressure, temp);
+    return true;
+  }
+
+private:
+  static inline void _decodeRaw(const uint8_t *buffer, int32_t *pressure,
+                                int16_t *temp) {
+    int32_t raw = (int32_t)buffer[2] << 16 | (uint16_t)buffer[1] << 8 |
+                  buffer[0];
+    *pressure = (raw & 0x800000) ? raw - 0x1000000 : raw;
+    *temp = (int16_t)((uint16_t)buffer[4] << 8 | buffer[3]);
+  }
+
+  static inline void _convert(int32_t raw_pressure, int16_t raw_temp,
+                              float *pressure, float *temp) {
+    *pressure = raw_pressure * (1.0f / 4096);
+    *temp = raw_temp * Chip::temp_scale + Chip::temp_offset;
+  }
+
+  typename Bus::device_t _dev;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*!
+ *  @file Adafruit_LPS2X_Group.cpp
+ *
+ * 	Batched reading of many LPS2X sensors
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_LPS2X_Group.h"
+
+#ifndef ARDUINO
+#include "Adafruit_LPS2X_HostClock.h"
+#endif
+
+/**
+ * @brief Construct a new, empty sensor group
+ *
+ * @param mode How `update` picks which sensors to read
+ */
+Adafruit_LPS2X_Group::Adafruit_LPS2X_Group(lps2x_group_mode_t mode) {
+  _mode = mode;
+  updated = 0;
+}
+
+/**
+ * @brief Adds an initialized sensor to the group. Sensors keep their own bus
+ * interface, so I2C and SPI sensors can be mixed
+ *
+ * @param sensor The sensor to add, after a successful `begin_*`
+ * @return true: the sensor was added
+ * @return false: the group is full
+ */
+bool Adafruit_LPS2X_Group::add(Adafruit_LPS2X *sensor) {
+  if (_count >= LPS2X_GROUP_MAX_SENSORS) {
+    return false;
+  }
+  _sensors[_count] = sensor;
+  pressure[_count] = 0;
+  temperature[_count] = 0;
+  timestamp[_count] = 0;
+  _count++;
+  return true;
+}
+
+/**
+ * @brief Gets the number of sensors in the group
+ *
+ * @return uint8_t The number of sensors added
+ */
+uint8_t Adafruit_LPS2X_Group::count(void) { return _count; }
+
+/**
+ * @brief Sets how `update` picks which sensors to read
+ *
+ * @param mode The scheduling mode. Must be a `lps2x_group_mode_t`
+ */
+void Adafruit_LPS2X_Group::setMode(lps2x_group_mode_t mode) { _mode = mode; }
+
+/**
+ * @brief Reads the next sensors in turn, starting after the last one read by
+ * the previous call. In `LPS2X_GROUP_DATA_READY` mode, sensors without a new
+ * sample are skipped and do not count towards `max_reads`
+ *
+ * @param max_reads The most sensors to read in this call, 0 for all of them
+ * @return uint8_t The number of sensors whose values were updated
+ */
+uint8_t Adafruit_LPS2X_Group::update(uint8_t max_reads) {
+  if (max_reads == 0 || max_reads > _count) {
+    max_reads = _count;
+  }
+
+  updated = 0;
+  uint8_t reads = 0;
+  for (uint8_t i = 0; i < _count && reads < max_reads; i++) {
+    uint8_t index = _next;
+    _next = (_next + 1) % _count;
+
+    if (_readSensor(index)) {
+      updated |= (uint32_t)1 << index;
+      reads++;
+    }
+  }
+  return reads;
+}
+
+/**
+ * @brief Reads one sensor into the shared buffer. STATUS sits directly
+ * before the output registers, so the data ready check and the data itself
+ * come from one burst read
+ *
+ * @param index The sensor to read
+ * @return true: new values were stored for the sensor
+ */
+bool Adafruit_LPS2X_Group::_readSensor(uint8_t index) {
+  Adafruit_LPS2X *sensor = _sensors[index];
+
+  if (!sensor->_readRegisters(LPS2X_STATUS, _buffer, 6)) {
+    return false;
+  }
+  if (_mode == LPS2X_GROUP_DATA_READY && (_buffer[0] & 0x03) != 0x03) {
+    return false;
+  }
+
+  sensor->_decode(_buffer + 1, &pressure[index], &temperature[index]);
+  timestamp[index] = micros();
+  return true;
+}
@@ -0,0 +1,66 @@
+/*!
+ *  @file Adafruit_LPS2X_Group.h
+ *
+ * 	Batched reading of many LPS2X sensors
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_GROUP_H
+#define _ADAFRUIT_LPS2X_GROUP_H
+
+#include "Adafruit_LPS2X.h"
+
+#ifndef LPS2X_GROUP_MAX_SENSORS
+#define LPS2X_GROUP_MAX_SENSORS                                                \
+  16 ///< Most sensors a group can hold, may be overridden up to 32
+#endif
+
+/**
+ * @brief
+ *
+ * Allowed values for `Adafruit_LPS2X_Group::setMode`.
+ */
+typedef enum {
+  LPS2X_GROUP_ROUND_ROBIN, ///< Read sensors in turn, ready or not
+  LPS2X_GROUP_DATA_READY,  ///< Only read sensors with a new sample
+} lps2x_group_mode_t;
+
+/*!
+ *    @brief  Reads a set of LPS2X sensors into packed per-field arrays
+ */
+class Adafruit_LPS2X_Group {
+public:
+  Adafruit_LPS2X_Group(lps2x_group_mode_t mode = LPS2X_GROUP_ROUND_ROBIN);
+
+  bool add(Adafruit_LPS2X *sensor);
+  uint8_t count(void);
+  void setMode(lps2x_group_mode_t mode);
+  uint8_t update(uint8_t max_reads = 0);
+
+  float pressure[LPS2X_GROUP_MAX_SENSORS];    ///< Last pressure (hPa)
+  float temperature[LPS2X_GROUP_MAX_SENSORS]; ///< Last temperature (C)
+  uint32_t timestamp[LPS2X_GROUP_MAX_SENSORS]; ///< `micros()` of last read
+  uint32_t updated; ///< Bit n set if sensor n was read by the last `update`
+
+private:
+  bool _readSensor(uint8_t index);
+
+  Adafruit_LPS2X *_sensors[LPS2X_GROUP_MAX_SENSORS];
+  uint8_t _count = 0;
+  uint8_t _next = 0;
+  lps2x_group_mode_t _mode;
+
+  // STATUS followed by PRESS_OUT_XL..TEMP_OUT_H, shared by every read
+  uint8_t _buffer[6];
+};
+
+#endif
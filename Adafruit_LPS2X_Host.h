@@ -0,0 +1,80 @@
+/*!
+ *  @file Adafruit_LPS2X_Host.h
+ *
+ * 	Stand-ins for the parts of the Unified Sensor library the driver uses,
+ * 	so it builds with a plain C++ compiler on a POSIX host and talks to the
+ * 	sensor through an `Adafruit_LPS2X_Transport`. Define
+ * 	LPS2X_USE_ADAFRUIT_SENSOR to use a port of the real library instead.
+ * 	The timing calls live in Adafruit_LPS2X_HostClock.h, which only the
+ * 	library's sources include
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_HOST_H
+#define _ADAFRUIT_LPS2X_HOST_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef LPS2X_USE_ADAFRUIT_SENSOR
+#include <Adafruit_Sensor.h>
+#else
+
+/** Sensor types used by the driver, with the Unified Sensor values */
+typedef enum {
+  SENSOR_TYPE_PRESSURE = 6,
+  SENSOR_TYPE_AMBIENT_TEMPERATURE = 13,
+} sensors_type_t;
+
+/** Unified Sensor event, laid out like the library's */
+typedef struct {
+  int32_t version;   ///< must be sizeof(struct sensors_event_t)
+  int32_t sensor_id; ///< unique sensor identifier
+  int32_t type;      ///< sensor type
+  int32_t reserved0; ///< reserved
+  int32_t timestamp; ///< time is in milliseconds
+  union {
+    float data[4];     ///< Raw data
+    float temperature; ///< temperature is in degrees centigrade (Celsius)
+    float pressure;    ///< pressure in hectopascal (hPa)
+  };                   ///< Union for the sensor data
+} sensors_event_t;
+
+/** Unified Sensor details, laid out like the library's */
+typedef struct {
+  char name[12];     ///< sensor name
+  int32_t version;   ///< version of the hardware + driver
+  int32_t sensor_id; ///< unique sensor identifier
+  int32_t type;      ///< this sensor's type (ex. SENSOR_TYPE_LIGHT)
+  float max_value;   ///< maximum value of this sensor's value in SI units
+  float min_value;   ///< minimum value of this sensor's value in SI units
+  float resolution;  ///< smallest difference between two values
+  int32_t min_delay; ///< min delay in microseconds between events
+} sensor_t;
+
+/** Unified Sensor interface */
+class Adafruit_Sensor {
+public:
+  virtual ~Adafruit_Sensor() {}
+
+  /** @brief Gets the latest sensor event
+      @returns True if the event was read */
+  virtual bool getEvent(sensors_event_t *) = 0;
+  /** @brief Gets the sensor's details */
+  virtual void getSensor(sensor_t *) = 0;
+};
+
+#endif // LPS2X_USE_ADAFRUIT_SENSOR
+
+#endif
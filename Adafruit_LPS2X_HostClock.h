@@ -0,0 +1,65 @@
+/*!
+ *  @file Adafruit_LPS2X_HostClock.h
+ *
+ * 	The Arduino timing and interrupt calls the driver makes, for builds
+ * 	without an Arduino core. Only the library's own sources include this,
+ * 	so programs with their own `millis` or `delay` still build against the
+ * 	public headers
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_HOSTCLOCK_H
+#define _ADAFRUIT_LPS2X_HOSTCLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+/** @brief Gets the time on the monotonic clock
+    @returns The time in microseconds, wrapping like the Arduino `micros()` */
+static inline uint32_t micros(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+/** @brief Gets the time on the monotonic clock
+    @returns The time in milliseconds, wrapping like the Arduino `millis()` */
+static inline uint32_t millis(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+/** @brief Sleeps for at least the given time
+    @param us The time in microseconds */
+static inline void delayMicroseconds(uint32_t us) {
+  struct timespec wait = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+  while (nanosleep(&wait, &wait) != 0) {
+  }
+}
+
+/** @brief Sleeps for at least the given time
+    @param ms The time in milliseconds */
+static inline void delay(uint32_t ms) {
+  struct timespec wait = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000};
+  while (nanosleep(&wait, &wait) != 0) {
+  }
+}
+
+/** @brief There are no interrupts to mask on a host. Samples handed between
+    threads rely on the driver's atomics instead */
+static inline void noInterrupts(void) {}
+
+/** @brief Counterpart of `noInterrupts` */
+static inline void interrupts(void) {}
+
+#endif
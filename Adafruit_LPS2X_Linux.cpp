@@ -0,0 +1,299 @@
+/*!
+ *  @file Adafruit_LPS2X_Linux.cpp
+ *
+ * 	Linux i2c-dev and spidev bus interfaces for LPS2X sensors
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_LPS2X_Linux.h"
+
+#ifdef LPS2X_HAS_LINUX_BUS
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/spi/spidev.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#ifndef ARDUINO
+#include "Adafruit_LPS2X_HostClock.h"
+#endif
+
+/**
+ * @brief Construct a new i2c-dev bus interface
+ *
+ * @param device The i2c-dev node, e.g. "/dev/i2c-1". Not copied
+ * @param address The sensor's I2C address
+ */
+Adafruit_LPS2X_LinuxI2C::Adafruit_LPS2X_LinuxI2C(const char *device,
+                                                 uint8_t address) {
+  _device = device;
+  _address = address;
+}
+
+/**
+ * @brief Closes the i2c-dev node
+ */
+Adafruit_LPS2X_LinuxI2C::~Adafruit_LPS2X_LinuxI2C(void) {
+  if (_fd >= 0) {
+    close(_fd);
+  }
+}
+
+/**
+ * @brief Opens the i2c-dev node
+ *
+ * @return true: the node was opened
+ */
+bool Adafruit_LPS2X_LinuxI2C::begin(void) {
+  if (_fd < 0) {
+    _fd = open(_device, O_RDWR);
+  }
+  return _fd >= 0;
+}
+
+/**
+ * @brief Gets which kind of bus this is
+ *
+ * @return false: this is I2C
+ */
+bool Adafruit_LPS2X_LinuxI2C::isSPI(void) { return false; }
+
+/**
+ * @brief Writes the register address and reads the registers back with a
+ * repeated start, in one ioctl
+ *
+ * @param addr The register address, with flags already set
+ * @param buffer Where to store the register contents
+ * @param len The number of registers to read
+ * @return true: the read succeeded
+ */
+bool Adafruit_LPS2X_LinuxI2C::read(uint8_t addr, uint8_t *buffer,
+                                   uint8_t len) {
+  struct i2c_msg msgs[2] = {{_address, 0, 1, &addr},
+                            {_address, I2C_M_RD, len, buffer}};
+  struct i2c_rdwr_ioctl_data data = {msgs, 2};
+  return ioctl(_fd, I2C_RDWR, &data) == 2;
+}
+
+/**
+ * @brief Writes the register address followed by the values in one ioctl
+ *
+ * @param addr The register address, with flags already set
+ * @param buffer The values to write
+ * @param len The number of registers to write
+ * @return true: the write succeeded
+ */
+bool Adafruit_LPS2X_LinuxI2C::write(uint8_t addr, const uint8_t *buffer,
+                                    uint8_t len) {
+  uint8_t message[256];
+  message[0] = addr;
+  memcpy(message + 1, buffer, len);
+
+  struct i2c_msg msg = {_address, 0, (uint16_t)(len + 1), message};
+  struct i2c_rdwr_ioctl_data data = {&msg, 1};
+  return ioctl(_fd, I2C_RDWR, &data) == 1;
+}
+
+/**
+ * @brief Construct a new spidev bus interface
+ *
+ * @param device The spidev node, e.g. "/dev/spidev0.0". Not copied
+ * @param frequency The SPI clock in Hz
+ */
+Adafruit_LPS2X_LinuxSPI::Adafruit_LPS2X_LinuxSPI(const char *device,
+                                                 uint32_t frequency) {
+  _device = device;
+  _frequency = frequency;
+}
+
+/**
+ * @brief Closes the spidev node
+ */
+Adafruit_LPS2X_LinuxSPI::~Adafruit_LPS2X_LinuxSPI(void) {
+  if (_fd >= 0) {
+    close(_fd);
+  }
+}
+
+/**
+ * @brief Opens the spidev node and sets mode 0, 8 bit words and the clock
+ *
+ * @return true: the node was opened and configured
+ */
+bool Adafruit_LPS2X_LinuxSPI::begin(void) {
+  if (_fd < 0) {
+    _fd = open(_device, O_RDWR);
+  }
+  if (_fd < 0) {
+    return false;
+  }
+
+  uint8_t mode = SPI_MODE_0;
+  uint8_t bits = 8;
+  return ioctl(_fd, SPI_IOC_WR_MODE, &mode) >= 0 &&
+         ioctl(_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) >= 0 &&
+         ioctl(_fd, SPI_IOC_WR_MAX_SPEED_HZ, &_frequency) >= 0;
+}
+
+/**
+ * @brief Gets which kind of bus this is
+ *
+ * @return true: this is SPI
+ */
+bool Adafruit_LPS2X_LinuxSPI::isSPI(void) { return true; }
+
+/**
+ * @brief Writes the register address and reads the registers back with CS
+ * held, in one ioctl
+ *
+ * @param addr The register address, with flags already set
+ * @param buffer Where to store the register contents
+ * @param len The number of registers to read
+ * @return true: the read succeeded
+ */
+bool Adafruit_LPS2X_LinuxSPI::read(uint8_t addr, uint8_t *buffer,
+                                   uint8_t len) {
+  return _transfer(addr, NULL, buffer, len);
+}
+
+/**
+ * @brief Writes the register address followed by the values with CS held,
+ * in one ioctl
+ *
+ * @param addr The register address, with flags already set
+ * @param buffer The values to write
+ * @param len The number of registers to write
+ * @return true: the write succeeded
+ */
+bool Adafruit_LPS2X_LinuxSPI::write(uint8_t addr, const uint8_t *buffer,
+                                    uint8_t len) {
+  return _transfer(addr, buffer, NULL, len);
+}
+
+/**
+ * @brief Sends the address byte and then either sends or receives the data,
+ * as two transfers of one SPI_IOC_MESSAGE so CS stays asserted
+ *
+ * @param addr The register address, with flags already set
+ * @param tx The data to send, or NULL to receive
+ * @param rx Where to store received data, or NULL to send
+ * @param len The number of data bytes
+ * @return true: the transfer succeeded
+ */
+bool Adafruit_LPS2X_LinuxSPI::_transfer(uint8_t addr, const uint8_t *tx,
+                                        uint8_t *rx, uint8_t len) {
+  struct spi_ioc_transfer xfer[2];
+  memset(xfer, 0, sizeof(xfer));
+
+  xfer[0].tx_buf = (unsigned long)&addr;
+  xfer[0].len = 1;
+  xfer[0].speed_hz = _frequency;
+  xfer[0].bits_per_word = 8;
+  xfer[1].tx_buf = (unsigned long)tx;
+  xfer[1].rx_buf = (unsigned long)rx;
+  xfer[1].len = len;
+  xfer[1].speed_hz = _frequency;
+  xfer[1].bits_per_word = 8;
+
+  return ioctl(_fd, SPI_IOC_MESSAGE(2), xfer) >= 0;
+}
+
+/**
+ * @brief Construct a new, empty batch
+ */
+Adafruit_LPS2X_LinuxI2CBatch::Adafruit_LPS2X_LinuxI2CBatch(void) {
+  updated = 0;
+}
+
+/**
+ * @brief Adds an initialized sensor to the batch. All sensors must be on the
+ * same I2C bus, at different addresses
+ *
+ * @param sensor The sensor to add, after a successful `begin_Transport`
+ * @param transport The i2c-dev interface the sensor was started with
+ * @return true: the sensor was added
+ * @return false: the batch is full or the sensor is on a different bus
+ */
+bool Adafruit_LPS2X_LinuxI2CBatch::add(Adafruit_LPS2X *sensor,
+                                       Adafruit_LPS2X_LinuxI2C *transport) {
+  if (_count >= LPS2X_LINUX_BATCH_MAX) {
+    return false;
+  }
+  if (_bus && strcmp(_bus->_device, transport->_device) != 0) {
+    return false;
+  }
+  if (!_bus) {
+    _bus = transport;
+  }
+
+  struct i2c_msg *msgs = &_msgs[2 * _count];
+  msgs[0].addr = transport->_address;
+  msgs[0].flags = 0;
+  msgs[0].len = 1;
+  msgs[0].buf = &_reg;
+  msgs[1].addr = transport->_address;
+  msgs[1].flags = I2C_M_RD;
+  msgs[1].len = 6;
+  msgs[1].buf = _buffers[_count];
+
+  _sensors[_count] = sensor;
+  pressure[_count] = 0;
+  temperature[_count] = 0;
+  timestamp[_count] = 0;
+  _count++;
+  return true;
+}
+
+/**
+ * @brief Gets the number of sensors in the batch
+ *
+ * @return uint8_t The number of sensors added
+ */
+uint8_t Adafruit_LPS2X_LinuxI2CBatch::count(void) { return _count; }
+
+/**
+ * @brief Reads STATUS and the output registers of every sensor in one
+ * ioctl, and stores the samples of sensors that had new data
+ *
+ * @return uint8_t The number of sensors whose values were updated
+ */
+uint8_t Adafruit_LPS2X_LinuxI2CBatch::update(void) {
+  updated = 0;
+  if (_count == 0) {
+    return 0;
+  }
+
+  struct i2c_rdwr_ioctl_data data = {_msgs, (uint32_t)(2 * _count)};
+  bool ok = ioctl(_bus->_fd, I2C_RDWR, &data) == (int)(2 * _count);
+  uint32_t now = micros();
+
+  uint8_t reads = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    Adafruit_LPS2X *sensor = _sensors[i];
+    // keep each sensor's own bus statistics meaningful
+    sensor->bus_stats.transactions++;
+    sensor->bus_stats.bytes += 3 + 6;
+    if (!ok) {
+      sensor->bus_stats.failures++;
+      continue;
+    }
+    if ((_buffers[i][0] & 0x03) != 0x03) {
+      continue;
+    }
+
+    sensor->_decode(_buffers[i] + 1, &pressure[i], &temperature[i]);
+    timestamp[i] = now;
+    updated |= (uint32_t)1 << i;
+    reads++;
+  }
+  return reads;
+}
+
+#endif // LPS2X_HAS_LINUX_BUS
@@ -0,0 +1,117 @@
+/*!
+ *  @file Adafruit_LPS2X_Linux.h
+ *
+ * 	Linux i2c-dev and spidev bus interfaces for LPS2X sensors. Outside an
+ * 	Arduino core the driver builds with a plain C++ compiler, using the
+ * 	stand-ins in Adafruit_LPS2X_Host.h and Adafruit_LPS2X_HostClock.h
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_LINUX_H
+#define _ADAFRUIT_LPS2X_LINUX_H
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/i2c-dev.h>) && __has_include(<linux/spi/spidev.h>)
+#define LPS2X_HAS_LINUX_BUS ///< The Linux bus interfaces are available
+#endif
+#endif
+
+#ifdef LPS2X_HAS_LINUX_BUS
+
+#include "Adafruit_LPS2X.h"
+#include <linux/i2c.h>
+
+#ifndef LPS2X_LINUX_BATCH_MAX
+#define LPS2X_LINUX_BATCH_MAX                                                  \
+  16 ///< Most sensors in a batch, at most 21 for the kernel's 42 messages
+#endif
+
+/*!
+ *    @brief  I2C through a Linux i2c-dev node such as /dev/i2c-1. Each
+ *            register read is a single I2C_RDWR ioctl holding the address
+ *            write and the data read
+ */
+class Adafruit_LPS2X_LinuxI2C : public Adafruit_LPS2X_Transport {
+public:
+  Adafruit_LPS2X_LinuxI2C(const char *device,
+                          uint8_t address = LPS2X_I2CADDR_DEFAULT);
+  ~Adafruit_LPS2X_LinuxI2C(void);
+
+  bool begin(void);
+  bool isSPI(void);
+  bool read(uint8_t addr, uint8_t *buffer, uint8_t len);
+  bool write(uint8_t addr, const uint8_t *buffer, uint8_t len);
+
+private:
+  friend class Adafruit_LPS2X_LinuxI2CBatch;
+
+  const char *_device;
+  uint8_t _address;
+  int _fd = -1;
+};
+
+/*!
+ *    @brief  SPI through a Linux spidev node such as /dev/spidev0.0. Each
+ *            register access is a single SPI_IOC_MESSAGE ioctl, with chip
+ *            select held between the address and the data
+ */
+class Adafruit_LPS2X_LinuxSPI : public Adafruit_LPS2X_Transport {
+public:
+  Adafruit_LPS2X_LinuxSPI(const char *device,
+                          uint32_t frequency = LPS2X_SPI_MAX_FREQ);
+  ~Adafruit_LPS2X_LinuxSPI(void);
+
+  bool begin(void);
+  bool isSPI(void);
+  bool read(uint8_t addr, uint8_t *buffer, uint8_t len);
+  bool write(uint8_t addr, const uint8_t *buffer, uint8_t len);
+
+private:
+  bool _transfer(uint8_t addr, const uint8_t *tx, uint8_t *rx, uint8_t len);
+
+  const char *_device;
+  uint32_t _frequency;
+  int _fd = -1;
+};
+
+/*!
+ *    @brief  Reads several sensors on one I2C bus with a single I2C_RDWR
+ *            ioctl. Each sensor contributes a STATUS and output register
+ *            burst, so one system call fetches a sample from every sensor
+ */
+class Adafruit_LPS2X_LinuxI2CBatch {
+public:
+  Adafruit_LPS2X_LinuxI2CBatch(void);
+
+  bool add(Adafruit_LPS2X *sensor, Adafruit_LPS2X_LinuxI2C *transport);
+  uint8_t count(void);
+  uint8_t update(void);
+
+  float pressure[LPS2X_LINUX_BATCH_MAX];    ///< Last pressure (hPa)
+  float temperature[LPS2X_LINUX_BATCH_MAX]; ///< Last temperature (C)
+  uint32_t timestamp[LPS2X_LINUX_BATCH_MAX]; ///< `micros()` of last sample
+  uint32_t updated; ///< Bit n set if sensor n had a new sample
+
+private:
+  Adafruit_LPS2X *_sensors[LPS2X_LINUX_BATCH_MAX];
+  Adafruit_LPS2X_LinuxI2C *_bus = NULL;
+  uint8_t _count = 0;
+
+  // the messages are built once by `add`, so `update` is just the ioctl
+  uint8_t _reg = LPS2X_STATUS | 0x80; // auto increment
+  uint8_t _buffers[LPS2X_LINUX_BATCH_MAX][6];
+  struct i2c_msg _msgs[2 * LPS2X_LINUX_BATCH_MAX];
+};
+
+#endif // LPS2X_HAS_LINUX_BUS
+
+#endif
@@ -0,0 +1,188 @@
+/*!
+ *  @file Adafruit_LPS2X_Log.cpp
+ *
+ * 	Compact binary log of raw LPS2X samples. Plain C++ with no Arduino
+ * 	dependency, so the reader also builds for host tools
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_LPS2X_Log.h"
+#include <string.h>
+
+/*!
+ *     @brief  Stores a little endian value
+ *     @param  buffer Where to store the value
+ *     @param  value The value to store
+ *     @param  len The number of bytes to store
+ */
+static void lps2x_log_put(uint8_t *buffer, uint32_t value, uint8_t len) {
+  for (uint8_t i = 0; i < len; i++) {
+    buffer[i] = (value >> (8 * i)) & 0xFF;
+  }
+}
+
+/*!
+ *     @brief  Loads a little endian value
+ *     @param  buffer The stored bytes
+ *     @param  len The number of bytes to load
+ *     @returns The value
+ */
+static uint32_t lps2x_log_get(const uint8_t *buffer, uint8_t len) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    value |= (uint32_t)buffer[i] << (8 * i);
+  }
+  return value;
+}
+
+/*!
+ *    @brief  Creates a writer
+ *    @param  write The function that stores the log's bytes
+ *    @param  context Passed to `write`, e.g. a file handle
+ */
+Adafruit_LPS2X_LogWriter::Adafruit_LPS2X_LogWriter(lps2x_log_write_t write,
+                                                   void *context) {
+  _write = write;
+  _context = context;
+}
+
+/*!
+ *    @brief  Writes the log header
+ *    @param  chip_id The chip's WHOAMI value, e.g. `LPS22HB_CHIP_ID`
+ *    @param  temp_scale Temperature in C per LSB, e.g. `LPS22_TEMP_SCALE`
+ *    @param  temp_offset Temperature in C at raw 0, e.g. `LPS22_TEMP_OFFSET`
+ *    @param  period_us The output data period, e.g. from
+ *            `Adafruit_LPS2X::getSamplePeriod`. 0 for one-shot, which puts
+ *            each sample in its own block
+ *    @returns True if the header was written
+ */
+bool Adafruit_LPS2X_LogWriter::begin(uint8_t chip_id, float temp_scale,
+                                     float temp_offset, uint32_t period_us) {
+  uint8_t header[LPS2X_LOG_HEADER_SIZE];
+  uint32_t bits;
+
+  memcpy(header, "LPS2", 4);
+  header[4] = LPS2X_LOG_VERSION;
+  header[5] = chip_id;
+  lps2x_log_put(header + 6, 0, 2);
+  memcpy(&bits, &temp_scale, 4);
+  lps2x_log_put(header + 8, bits, 4);
+  memcpy(&bits, &temp_offset, 4);
+  lps2x_log_put(header + 12, bits, 4);
+  lps2x_log_put(header + 16, period_us, 4);
+
+  _period = period_us;
+  _count = 0;
+  return _write(header, sizeof(header), _context);
+}
+
+/*!
+ *    @brief  Adds a raw sample. Samples one output data period apart are
+ *            buffered into the current block, which is written once full
+ *            or when a sample is late, early or missing. Within half a
+ *            period counts as on time, to allow for interrupt latency
+ *    @param  timestamp `micros()` when the sample was converted
+ *    @param  pressure Raw 24-bit pressure, 4096 LSB/hPa
+ *    @param  temperature Raw 16-bit temperature
+ *    @returns True unless writing a full block failed
+ */
+bool Adafruit_LPS2X_LogWriter::add(uint32_t timestamp, int32_t pressure,
+                                   int16_t temperature) {
+  bool ok = true;
+  if (_count) {
+    int32_t error = (int32_t)(timestamp - _start - _count * _period);
+    if (_count >= LPS2X_LOG_BLOCK_RECORDS || _period == 0 ||
+        error > (int32_t)(_period / 2) || error < -(int32_t)(_period / 2)) {
+      ok = flush();
+    }
+  }
+  if (_count == 0) {
+    _start = timestamp;
+  }
+
+  uint8_t *record =
+      _block + LPS2X_LOG_BLOCK_HEADER_SIZE + _count * LPS2X_RECORD_SIZE;
+  lps2x_log_put(record, (uint32_t)pressure, 3);
+  lps2x_log_put(record + 3, (uint16_t)temperature, 2);
+  _count++;
+  return ok;
+}
+
+/*!
+ *    @brief  Writes the buffered block, e.g. before closing the file
+ *    @returns True if the block was written. The block is dropped either
+ *             way, so a failing store does not stall logging
+ */
+bool Adafruit_LPS2X_LogWriter::flush(void) {
+  if (_count == 0) {
+    return true;
+  }
+
+  lps2x_log_put(_block, _start, 4);
+  lps2x_log_put(_block + 4, _count, 2);
+  size_t len = LPS2X_LOG_BLOCK_HEADER_SIZE + _count * LPS2X_RECORD_SIZE;
+  _count = 0;
+  return _write(_block, len, _context);
+}
+
+/*!
+ *    @brief  Checks the header of a log in memory and starts reading it
+ *    @param  data The log. It must stay valid while blocks are read
+ *    @param  len The log's length in bytes
+ *    @returns True if the data starts with a supported log header
+ */
+bool Adafruit_LPS2X_LogReader::begin(const uint8_t *data, size_t len) {
+  if (len < LPS2X_LOG_HEADER_SIZE || memcmp(data, "LPS2", 4) != 0 ||
+      data[4] != LPS2X_LOG_VERSION) {
+    return false;
+  }
+
+  uint32_t bits;
+  _chip_id = data[5];
+  bits = lps2x_log_get(data + 8, 4);
+  memcpy(&_temp_scale, &bits, 4);
+  bits = lps2x_log_get(data + 12, 4);
+  memcpy(&_temp_offset, &bits, 4);
+  _period = lps2x_log_get(data + 16, 4);
+
+  _data = data;
+  _len = len;
+  _pos = LPS2X_LOG_HEADER_SIZE;
+  return true;
+}
+
+/*!
+ *    @brief  Gets the next block of records. A block cut short at the end
+ *            of the log, e.g. by a power loss while writing, is returned
+ *            with the records that are complete
+ *    @param  block The block to fill. Its records point into the log
+ *    @returns False at the end of the log
+ */
+bool Adafruit_LPS2X_LogReader::nextBlock(lps2x_log_block_t *block) {
+  if (_len - _pos < LPS2X_LOG_BLOCK_HEADER_SIZE) {
+    return false;
+  }
+
+  const uint8_t *header = _data + _pos;
+  size_t available =
+      (_len - _pos - LPS2X_LOG_BLOCK_HEADER_SIZE) / LPS2X_RECORD_SIZE;
+  uint16_t count = lps2x_log_get(header + 4, 2);
+  if (count > available) {
+    count = available;
+  }
+  if (count == 0) {
+    return false;
+  }
+
+  block->start = lps2x_log_get(header, 4);
+  block->period = _period;
+  block->count = count;
+  block->records = header + LPS2X_LOG_BLOCK_HEADER_SIZE;
+  _pos += LPS2X_LOG_BLOCK_HEADER_SIZE + count * LPS2X_RECORD_SIZE;
+  return true;
+}
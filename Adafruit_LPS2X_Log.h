@@ -0,0 +1,123 @@
+/*!
+ *  @file Adafruit_LPS2X_Log.h
+ *
+ * 	Compact binary log of raw LPS2X samples
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_LOG_H
+#define _ADAFRUIT_LPS2X_LOG_H
+
+#include "Adafruit_LPS2X_Decode.h"
+
+/*
+ * All fields are little endian.
+ *
+ * Header, LPS2X_LOG_HEADER_SIZE bytes:
+ *   0  "LPS2" magic
+ *   4  uint8   format version, LPS2X_LOG_VERSION
+ *   5  uint8   chip WHOAMI value
+ *   6  uint16  reserved, 0
+ *   8  float   temperature scale, C per LSB
+ *   12 float   temperature offset, C at raw 0
+ *   16 uint32  output data period in us, 0 for one-shot
+ *
+ * Then any number of blocks, LPS2X_LOG_BLOCK_HEADER_SIZE bytes each plus
+ * LPS2X_RECORD_SIZE bytes per record:
+ *   0  uint32  `micros()` when the first record was converted
+ *   4  uint16  number of records
+ *   6  records, the raw PRESS_OUT_XL..TEMP_OUT_H bytes
+ *
+ * Record n of a block was converted at start + n * period. A new block is
+ * started whenever a sample does not fall on that grid.
+ */
+
+#define LPS2X_LOG_VERSION 1           ///< Format version written
+#define LPS2X_LOG_HEADER_SIZE 20      ///< Bytes in the file header
+#define LPS2X_LOG_BLOCK_HEADER_SIZE 6 ///< Bytes in a block header
+
+#ifndef LPS2X_LOG_BLOCK_RECORDS
+#define LPS2X_LOG_BLOCK_RECORDS 32 ///< Records the writer buffers per block
+#endif
+
+/** Writes bytes of the log to storage
+    @param data The bytes to write
+    @param len The number of bytes
+    @param context The pointer given to the writer
+    @returns True if all bytes were written */
+typedef bool (*lps2x_log_write_t)(const uint8_t *data, size_t len,
+                                  void *context);
+
+/** A block of records from a log, pointing into the log's memory */
+typedef struct {
+  uint32_t start;         ///< `micros()` of the first record
+  uint32_t period;        ///< us between records
+  uint16_t count;         ///< Number of records
+  const uint8_t *records; ///< `count` raw records, `LPS2X_RECORD_SIZE` each
+} lps2x_log_block_t;
+
+/*!
+ *    @brief  Streams raw samples to a log through a write callback, one
+ *            block at a time, so it needs only one block of RAM
+ */
+class Adafruit_LPS2X_LogWriter {
+public:
+  Adafruit_LPS2X_LogWriter(lps2x_log_write_t write, void *context = NULL);
+
+  bool begin(uint8_t chip_id, float temp_scale, float temp_offset,
+             uint32_t period_us);
+  bool add(uint32_t timestamp, int32_t pressure, int16_t temperature);
+  bool flush(void);
+
+private:
+  lps2x_log_write_t _write;
+  void *_context;
+  uint32_t _period = 0;
+  uint32_t _start = 0;
+  uint16_t _count = 0;
+  uint8_t _block[LPS2X_LOG_BLOCK_HEADER_SIZE +
+                 LPS2X_LOG_BLOCK_RECORDS * LPS2X_RECORD_SIZE];
+};
+
+/*!
+ *    @brief  Walks the blocks of a log held in memory, e.g. a mapped file,
+ *            without copying the records
+ */
+class Adafruit_LPS2X_LogReader {
+public:
+  bool begin(const uint8_t *data, size_t len);
+  bool nextBlock(lps2x_log_block_t *block);
+
+  /** @brief Gets the chip that wrote the log
+      @returns The chip's WHOAMI value */
+  uint8_t chipID(void) { return _chip_id; }
+  /** @brief Gets the temperature scale for `lps2x_decode_records`
+      @returns C per LSB */
+  float tempScale(void) { return _temp_scale; }
+  /** @brief Gets the temperature offset for `lps2x_decode_records`
+      @returns C at raw 0 */
+  float tempOffset(void) { return _temp_offset; }
+  /** @brief Gets the output data period the log was written at
+      @returns us between samples, 0 for one-shot */
+  uint32_t period(void) { return _period; }
+
+private:
+  const uint8_t *_data = NULL;
+  size_t _len = 0;
+  size_t _pos = 0;
+  uint8_t _chip_id = 0;
+  float _temp_scale = 0;
+  float _temp_offset = 0;
+  uint32_t _period = 0;
+};
+
+#endif
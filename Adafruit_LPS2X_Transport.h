@@ -0,0 +1,58 @@
+/*!
+ *  @file Adafruit_LPS2X_Transport.h
+ *
+ * 	Pluggable bus interface for LPS2X sensors
+ *
+ * 	This is a library for the Adafruit LPS2X breakout:
+ * 	https://www.adafruit.com/products/4530
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_LPS2X_TRANSPORT_H
+#define _ADAFRUIT_LPS2X_TRANSPORT_H
+
+#include <stdint.h>
+
+/*!
+ *    @brief  A bus interface for `Adafruit_LPS2X::begin_Transport`, for
+ *            platforms without BusIO. The driver sets the register address
+ *            flags (read and auto increment bits) for the kind of bus the
+ *            transport reports, so implementations only move bytes
+ */
+class Adafruit_LPS2X_Transport {
+public:
+  virtual ~Adafruit_LPS2X_Transport(void) {}
+
+  /** @brief Opens the bus
+      @returns True if the bus is ready */
+  virtual bool begin(void) = 0;
+
+  /** @brief Gets which kind of bus this is, as the register address flags
+      differ between I2C and SPI
+      @returns True for SPI, false for I2C */
+  virtual bool isSPI(void) = 0;
+
+  /** @brief Writes the register address and reads the registers back as one
+      transaction, with a repeated start on I2C or CS held on SPI
+      @param addr The register address, with flags already set
+      @param buffer Where to store the register contents
+      @param len The number of registers to read
+      @returns True if the read succeeded */
+  virtual bool read(uint8_t addr, uint8_t *buffer, uint8_t len) = 0;
+
+  /** @brief Writes the register address followed by the values as one
+      transaction
+      @param addr The register address, with flags already set
+      @param buffer The values to write
+      @param len The number of registers to write
+      @returns True if the write succeeded */
+  virtual bool write(uint8_t addr, const uint8_t *buffer, uint8_t len) = 0;
+};
+
+#endif
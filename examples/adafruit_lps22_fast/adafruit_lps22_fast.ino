@@ -0,0 +1,33 @@
+// Demo for the compile time specialized LPS22 driver over I2C
+#include <Adafruit_LPS2X_Fast.h>
+
+Adafruit_LPS2X_Fast<LPS2X_Chip22, LPS2X_BusI2C> lps(LPS2X_I2CADDR_DEFAULT,
+                                                    &Wire);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit LPS22 fast driver test!");
+
+  if (!lps.begin()) {
+    Serial.println("Failed to find LPS22 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("LPS22 Found!");
+
+  lps.setDataRate(LPS22_RATE_75_HZ);
+}
+
+void loop() {
+  float pressure, temp;
+  if (lps.poll(&pressure, &temp)) {
+    Serial.print(pressure);
+    Serial.print(" hPa, ");
+    Serial.print(temp);
+    Serial.println(" C");
+  }
+}
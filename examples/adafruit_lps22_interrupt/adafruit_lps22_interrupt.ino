@@ -0,0 +1,51 @@
+// Demo for interrupt driven, buffered readings from the LPS22
+#include <Adafruit_LPS2X.h>
+
+// Connect the sensor's INT pin to an interrupt capable pin
+#define LPS_INT 2
+
+Adafruit_LPS22 lps;
+lps2x_raw_sample_t samples[16]; // must be a power of two
+
+void lpsISR(void) { lps.handleInterrupt(); }
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit LPS22 interrupt test!");
+
+  if (!lps.begin_I2C()) {
+    Serial.println("Failed to find LPS22 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("LPS22 Found!");
+
+  lps.setDataRate(LPS22_RATE_75_HZ);
+  // INT pin is driven high on data ready
+  lps.configureInterrupt(false, false, true);
+  lps.enableSampleBuffer(samples, 16);
+
+  pinMode(LPS_INT, INPUT);
+  attachInterrupt(digitalPinToInterrupt(LPS_INT), lpsISR, RISING);
+}
+
+void loop() {
+  // move any flagged samples into the buffer
+  lps.service();
+
+  // and take them out whenever convenient
+  lps2x_raw_sample_t raw;
+  lps2x_sample_t sample;
+  while (lps.readBufferedSample(&raw)) {
+    lps.convertSample(&raw, &sample);
+    Serial.print(raw.timestamp);
+    Serial.print(",");
+    Serial.print(sample.pressure);
+    Serial.print(",");
+    Serial.println(sample.temperature);
+  }
+}
@@ -0,0 +1,42 @@
+// Demo for filtered altitude and vertical speed from the LPS22
+#include <Adafruit_LPS2X.h>
+#include <Adafruit_LPS2X_Altitude.h>
+
+Adafruit_LPS22 lps;
+Adafruit_LPS2X_Altitude altitude;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit LPS22 altitude test!");
+
+  if (!lps.begin_I2C()) {
+    Serial.println("Failed to find LPS22 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("LPS22 Found!");
+
+  lps.setDataRate(LPS22_RATE_75_HZ);
+
+  // measure altitude relative to where we start
+  sensors_event_t pressure, temp;
+  lps.getEvent(&pressure, &temp);
+  altitude.setSeaLevelPressure(pressure.pressure);
+}
+
+void loop() {
+  sensors_event_t pressure, temp;
+  if (lps.poll(&pressure, &temp)) {
+    altitude.update(pressure.pressure, micros());
+
+    Serial.print("Altitude: ");
+    Serial.print(altitude.getAltitude());
+    Serial.print(" m, vertical speed: ");
+    Serial.print(altitude.getVerticalSpeed());
+    Serial.println(" m/s");
+  }
+}
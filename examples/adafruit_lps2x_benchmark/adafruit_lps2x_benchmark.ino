@@ -0,0 +1,188 @@
+// Measures the bus and CPU cost of common LPS2X operations.
+// Prints one CSV line per operation:
+//   chip,bus,operation,transactions,bytes,us,bus_us
+// where the counts are per call, us is the measured wall time per call and
+// bus_us is the time the bytes alone occupy the bus at BUS_CLOCK_HZ
+
+#include <Adafruit_LPS2X.h>
+
+// Use LPS25 or LPS22 here
+#define USE_LPS22
+// Use BUS_I2C, BUS_SPI or BUS_SOFT_SPI here
+#define BUS_I2C
+// The bus clock, used to estimate time on the bus
+#define BUS_CLOCK_HZ 400000
+
+// For SPI mode, we need a CS pin
+#define LPS_CS 10
+// For software-SPI mode we need SCK/MOSI/MISO pins
+#define LPS_SCK 13
+#define LPS_MISO 12
+#define LPS_MOSI 11
+
+#define ITERATIONS 100
+
+#ifdef USE_LPS22
+Adafruit_LPS22 lps;
+#define CHIP_NAME "LPS22"
+#else
+Adafruit_LPS25 lps;
+#define CHIP_NAME "LPS25"
+#endif
+
+#if defined(BUS_I2C)
+#define BUS_NAME "i2c"
+#define BITS_PER_BYTE 9 // 8 data bits plus ACK
+#elif defined(BUS_SPI)
+#define BUS_NAME "spi"
+#define BITS_PER_BYTE 8
+#else
+#define BUS_NAME "soft_spi"
+#define BITS_PER_BYTE 8
+#endif
+
+Adafruit_Sensor *lps_temp, *lps_pressure;
+sensors_event_t pressure, temp;
+
+uint32_t bench_start;
+
+void beginOp(void) {
+  lps.resetBusStats();
+  bench_start = micros();
+}
+
+void endOp(const char *name, uint16_t calls) {
+  uint32_t elapsed = micros() - bench_start;
+  lps2x_bus_stats_t stats;
+  lps.getBusStats(&stats);
+
+  float transactions = (float)stats.transactions / calls;
+  float bytes = (float)stats.bytes / calls;
+  float bus_us = bytes * BITS_PER_BYTE * 1000000.0 / BUS_CLOCK_HZ;
+
+  Serial.print(CHIP_NAME ",");
+  Serial.print(BUS_NAME ",");
+  Serial.print(name);
+  Serial.print(",");
+  Serial.print(transactions);
+  Serial.print(",");
+  Serial.print(bytes);
+  Serial.print(",");
+  Serial.print((float)elapsed / calls);
+  Serial.print(",");
+  Serial.println(bus_us);
+}
+
+void setContinuous(void) {
+#ifdef USE_LPS22
+  lps.setDataRate(LPS22_RATE_75_HZ);
+#else
+  lps.setDataRate(LPS25_RATE_25_HZ);
+#endif
+}
+
+void setOneShot(void) {
+#ifdef USE_LPS22
+  lps.setDataRate(LPS22_RATE_ONE_SHOT);
+#else
+  lps.setDataRate(LPS25_RATE_ONE_SHOT);
+#endif
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+#if defined(BUS_I2C)
+  if (!lps.begin_I2C()) {
+#elif defined(BUS_SPI)
+  if (!lps.begin_SPI(LPS_CS)) {
+#else
+  if (!lps.begin_SPI(LPS_CS, LPS_SCK, LPS_MISO, LPS_MOSI)) {
+#endif
+    Serial.println("Failed to find LPS2X chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  lps_temp = lps.getTemperatureSensor();
+  lps_pressure = lps.getPressureSensor();
+
+  Serial.println("chip,bus,operation,transactions,bytes,us,bus_us");
+
+  setContinuous();
+
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    lps.getEvent(&pressure, &temp);
+  }
+  endOp("getEvent", ITERATIONS);
+
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    lps_temp->getEvent(&temp);
+    lps_pressure->getEvent(&pressure);
+  }
+  endOp("unified_getEvent_pair", ITERATIONS);
+
+  lps.setSampleCaching(true);
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    lps_temp->getEvent(&temp);
+    lps_pressure->getEvent(&pressure);
+  }
+  endOp("unified_getEvent_pair_cached", ITERATIONS);
+  lps.setSampleCaching(false);
+
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    setContinuous();
+  }
+  endOp("setDataRate", ITERATIONS);
+
+  beginOp();
+  for (uint16_t i = 0; i < 10; i++) {
+    lps.reset();
+  }
+  endOp("reset", 10);
+#ifndef USE_LPS22
+  lps.powerDown(false); // a reset leaves the LPS25 powered down
+#endif
+  setContinuous();
+
+  setOneShot();
+  beginOp();
+  for (uint16_t i = 0; i < 10; i++) {
+    lps.getEvent(&pressure, &temp);
+  }
+  endOp("one_shot_getEvent", 10);
+  setContinuous();
+
+  // CPU cost of converting a raw sample, without any bus traffic
+  lps2x_raw_sample_t raw;
+  lps2x_sample_t sample;
+  lps.readRaw(&raw);
+
+  volatile float float_sink;
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    raw.pressure += i & 1;
+    lps.convertSample(&raw, &sample);
+    float_sink = sample.pressure + sample.temperature;
+  }
+  endOp("decode_float", ITERATIONS);
+  (void)float_sink;
+
+  volatile int32_t fixed_sink;
+  beginOp();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    raw.pressure += i & 1;
+    fixed_sink = lps.rawToPressureFixed(raw.pressure) +
+                 lps.rawToTemperatureFixed(raw.temperature);
+  }
+  endOp("decode_fixed", ITERATIONS);
+  (void)fixed_sink;
+}
+
+void loop() { delay(1000); }
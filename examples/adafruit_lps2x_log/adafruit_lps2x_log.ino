@@ -0,0 +1,38 @@
+// Streams raw LPS22 samples to the serial port in the compact binary log
+// format. Capture the port to a file on the host and read it back with
+// Adafruit_LPS2X_LogReader
+#include <Adafruit_LPS2X.h>
+#include <Adafruit_LPS2X_Log.h>
+
+Adafruit_LPS22 lps;
+
+bool writeSerial(const uint8_t *data, size_t len, void *context) {
+  (void)context;
+  return Serial.write(data, len) == len;
+}
+
+Adafruit_LPS2X_LogWriter logger(writeSerial);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  if (!lps.begin_I2C()) {
+    while (1) {
+      delay(10);
+    }
+  }
+
+  lps.setDataRate(LPS22_RATE_25_HZ);
+  logger.begin(LPS22HB_CHIP_ID, LPS22_TEMP_SCALE, LPS22_TEMP_OFFSET,
+               lps.getSamplePeriod());
+}
+
+void loop() {
+  // each sample is 5 bytes in the log, plus 6 bytes per block of 32
+  lps2x_raw_sample_t raw;
+  if (lps.isMeasurementReady() && lps.readRaw(&raw)) {
+    logger.add(raw.timestamp, raw.pressure, raw.temperature);
+  }
+}
@@ -21,6 +21,9 @@ void setup(void) {
   }
 
   Serial.println("LPS2X Found!");
+  // let the temperature and pressure sensors share one read per sample
+  lps.setSampleCaching(true);
+
   lps_temp = lps.getTemperatureSensor();
   lps_temp->printSensorDetails();
 
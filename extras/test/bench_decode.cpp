@@ -0,0 +1,63 @@
+/*!
+ *  @file bench_decode.cpp
+ *
+ * 	Times `lps2x_decode_records_scalar` against the batch
+ * 	`lps2x_decode_records` on a million random records, and checks that
+ * 	both give the same floats
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include <Adafruit_LPS2X_Decode.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static const size_t samples = 1000000; ///< Records decoded per run
+static const int runs = 30;            ///< Runs, of which the best counts
+
+typedef void (*decode_t)(const uint8_t *, size_t, float, float, float *,
+                         float *);
+
+/** Prints and returns the best time of `runs` decodes, in ms */
+static double bench(const char *name, decode_t decode,
+                    const std::vector<uint8_t> &records, float *pressure,
+                    float *temperature) {
+  double best = 1e9;
+  for (int i = 0; i < runs; i++) {
+    auto start = std::chrono::steady_clock::now();
+    decode(records.data(), samples, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET,
+           pressure, temperature);
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (ms < best) {
+      best = ms;
+    }
+  }
+  printf("%-8s %8.3f ms %6.2f ns/sample\n", name, best, best * 1e6 / samples);
+  return best;
+}
+
+int main(void) {
+  std::vector<uint8_t> records(samples * LPS2X_RECORD_SIZE);
+  srand(1);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i] = (uint8_t)rand();
+  }
+
+  std::vector<float> p_scalar(samples), t_scalar(samples);
+  std::vector<float> p_batch(samples), t_batch(samples);
+  double scalar = bench("scalar", lps2x_decode_records_scalar, records,
+                        p_scalar.data(), t_scalar.data());
+  double batch = bench("batch", lps2x_decode_records, records, p_batch.data(),
+                       t_batch.data());
+  printf("speedup  %8.2fx\n", scalar / batch);
+
+  size_t size = samples * sizeof(float);
+  bool same = !memcmp(p_scalar.data(), p_batch.data(), size) &&
+              !memcmp(t_scalar.data(), t_batch.data(), size);
+  printf("%s\n", same ? "outputs match" : "OUTPUTS DIFFER");
+  return same ? 0 : 1;
+}
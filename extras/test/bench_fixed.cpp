@@ -0,0 +1,113 @@
+/*!
+ *  @file bench_fixed.cpp
+ *
+ * 	Times the float `convertSample` against the integer
+ * 	`rawToPressureFixed` and `rawToTemperatureFixed` over every raw value,
+ * 	and checks the two paths agree to within one LSB of the fixed point
+ * 	units on both chips. Hosts have an FPU, so expect the float path to
+ * 	win here; the fixed point path is for cores without one
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include <Adafruit_LPS2X.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+static const int32_t press_min = -0x800000; ///< Lowest 24-bit raw pressure
+static const int32_t press_max = 0x7FFFFF;  ///< Highest 24-bit raw pressure
+static const int runs = 5;                  ///< Runs, of which the best counts
+
+static volatile float float_sink;   ///< Keeps the float results alive
+static volatile int32_t fixed_sink; ///< Keeps the fixed results alive
+
+/** Converts every raw pressure, with the temperature wrapping alongside */
+static void run_float(Adafruit_LPS2X *lps) {
+  lps2x_raw_sample_t raw = {0, 0, 0};
+  lps2x_sample_t sample;
+  for (int32_t p = press_min; p <= press_max; p++) {
+    raw.pressure = p;
+    raw.temperature = (int16_t)p;
+    lps->convertSample(&raw, &sample);
+    float_sink = sample.pressure + sample.temperature;
+  }
+}
+
+/** The same conversions as `run_float`, in fixed point */
+static void run_fixed(Adafruit_LPS2X *lps) {
+  for (int32_t p = press_min; p <= press_max; p++) {
+    fixed_sink = lps->rawToPressureFixed(p) + lps->rawToTemperatureFixed(p);
+  }
+}
+
+/** Prints and returns the best time of `runs` passes, in ms */
+static double bench(const char *name, void (*pass)(Adafruit_LPS2X *),
+                    Adafruit_LPS2X *lps) {
+  double best = 1e9;
+  for (int i = 0; i < runs; i++) {
+    auto start = std::chrono::steady_clock::now();
+    pass(lps);
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (ms < best) {
+      best = ms;
+    }
+  }
+  double samples = (double)press_max - press_min + 1;
+  printf("%-8s %8.3f ms %6.2f ns/sample\n", name, best, best * 1e6 / samples);
+  return best;
+}
+
+/** Counts raw values where the paths differ by more than one LSB of the
+    fixed point units, Pa * 16 and hundredths of a degree */
+static uint32_t mismatches(Adafruit_LPS2X *lps) {
+  uint32_t bad = 0;
+  lps2x_raw_sample_t raw = {0, 0, 0};
+  lps2x_sample_t sample;
+  for (int32_t p = press_min; p <= press_max; p++) {
+    raw.pressure = p;
+    lps->convertSample(&raw, &sample);
+    if (fabs(sample.pressure * 1600.0 - lps->rawToPressureFixed(p)) > 1) {
+      bad++;
+    }
+  }
+  for (int32_t t = -0x8000; t <= 0x7FFF; t++) {
+    raw.temperature = (int16_t)t;
+    lps->convertSample(&raw, &sample);
+    int16_t fixed = lps->rawToTemperatureFixed((int16_t)t);
+    if (fabs(sample.temperature * 100.0 - fixed) > 1) {
+      bad++;
+    }
+  }
+  return bad;
+}
+
+/** Benchmarks and checks one chip
+    @returns True if the paths agree */
+static bool run_chip(const char *name, uint8_t chip_id, Adafruit_LPS2X *lps) {
+  LPS2XSim sim(chip_id);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  if (!lps->begin_I2C()) {
+    printf("%s: begin failed\n", name);
+    return false;
+  }
+
+  printf("%s\n", name);
+  double float_ms = bench("float", run_float, lps);
+  double fixed_ms = bench("fixed", run_fixed, lps);
+  printf("speedup  %8.2fx\n", float_ms / fixed_ms);
+
+  uint32_t bad = mismatches(lps);
+  printf("%s\n", bad ? "PATHS DIFFER" : "within 1 LSB");
+  return bad == 0;
+}
+
+int main(void) {
+  Adafruit_LPS22 lps22;
+  Adafruit_LPS25 lps25;
+  bool ok = run_chip("LPS22", LPS22HB_CHIP_ID, &lps22);
+  ok = run_chip("LPS25", LPS25HB_CHIP_ID, &lps25) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,550 @@
+/*!
+ *  @file lps2x_sim.cpp
+ *
+ * 	Register level simulator of the LPS22HB and LPS25HB for host tests
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include <math.h>
+#include <string.h>
+
+std::atomic<uint64_t> lps2x_sim_clock(0);
+
+#define SIM_CHIP_LPS22 0xB1 ///< LPS22HB WHOAMI
+#define SIM_WHOAMI 0x0F     ///< Chip ID register
+#define SIM_INT_SOURCE 0x25 ///< Threshold event flags
+#define SIM_STATUS 0x27     ///< Data available and overrun flags
+#define SIM_OUT 0x28        ///< PRESS_OUT_XL, first of five output registers
+#define SIM_OUT_END 0x2C    ///< TEMP_OUT_H, last output register
+
+/** Register addresses that differ between the chips */
+struct sim_map_t {
+  uint8_t int_cfg, ths_p, ctrl1, ctrl2, ctrl3, fifo_ctrl, ref_p, rpds,
+      res_conf, fifo_status;
+};
+
+static const sim_map_t lps22_map = {0x0B, 0x0C, 0x10, 0x11, 0x12,
+                                    0x14, 0x15, 0x18, 0x1A, 0x26};
+static const sim_map_t lps25_map = {0x24, 0x30, 0x20, 0x21, 0x22,
+                                    0x2E, 0x08, 0x39, 0x10, 0x2F};
+
+/** Output data periods in microseconds by ODR field */
+static const uint32_t lps22_periods[8] = {0,     1000000, 100000, 40000,
+                                          20000, 13333,   13333,  13333};
+static const uint32_t lps25_periods[8] = {0,     1000000, 142857, 80000,
+                                          40000, 40000,   40000,  40000};
+
+static LPS2XSim *sim_i2c[128];
+static LPS2XSim *sim_spi[64];
+
+/*!
+ *    @brief  Creates a powered up chip, not yet attached to a bus
+ *    @param  chip_id 0xB1 for an LPS22HB or 0xBD for an LPS25HB
+ */
+LPS2XSim::LPS2XSim(uint8_t chip_id) {
+  _chip_id = chip_id;
+  _defaults();
+}
+
+/*!
+ *    @brief  Detaches the chip from the bus
+ */
+LPS2XSim::~LPS2XSim(void) {
+  for (uint8_t i = 0; i < 128; i++) {
+    if (sim_i2c[i] == this) {
+      sim_i2c[i] = NULL;
+    }
+  }
+  for (uint8_t i = 0; i < 64; i++) {
+    if (sim_spi[i] == this) {
+      sim_spi[i] = NULL;
+    }
+  }
+}
+
+/*!
+ *    @brief  Puts the chip on the I2C bus
+ *    @param  address The 7-bit address
+ */
+void LPS2XSim::attachI2C(uint8_t address) { sim_i2c[address & 0x7F] = this; }
+
+/*!
+ *    @brief  Puts the chip on the SPI bus
+ *    @param  cs_pin Its chip select pin
+ */
+void LPS2XSim::attachSPI(int8_t cs_pin) { sim_spi[cs_pin & 0x3F] = this; }
+
+/*!
+ *    @brief  Finds the chip at an I2C address
+ *    @param  address The 7-bit address
+ *    @returns The chip, or NULL if nothing acknowledges
+ */
+LPS2XSim *LPS2XSim::findI2C(uint8_t address) {
+  return sim_i2c[address & 0x7F];
+}
+
+/*!
+ *    @brief  Finds the chip on a chip select pin
+ *    @param  cs_pin The chip select pin
+ *    @returns The chip, or NULL if none
+ */
+LPS2XSim *LPS2XSim::findSPI(int8_t cs_pin) { return sim_spi[cs_pin & 0x3F]; }
+
+/*!
+ *    @brief  Handles a register read transaction
+ *    @param  addr The address byte, with the chip's increment and SPI read
+ *            flags
+ *    @param  buffer Where to store the register contents
+ *    @param  len The number of bytes clocked out
+ *    @param  spi True for SPI, where the address has a read flag
+ *    @returns False if the transaction was NACKed
+ */
+bool LPS2XSim::read(uint8_t addr, uint8_t *buffer, size_t len, bool spi) {
+  std::lock_guard<std::mutex> guard(_lock);
+  uint8_t reg = addr & (spi ? 0x3F : 0x7F);
+  if (_fail(spi ? 1 : 3, len) || reg == fail_read_reg) {
+    return false;
+  }
+  _run(lps2x_sim_clock);
+
+  bool increment;
+  if (_isLPS22()) {
+    increment = _regs[lps22_map.ctrl2] & 0x10; // IF_ADD_INC
+  } else {
+    increment = addr & (spi ? 0x40 : 0x80);
+  }
+  for (size_t i = 0; i < len; i++) {
+    buffer[i] = _readReg(reg);
+    if (!increment) {
+      continue;
+    }
+    if (reg == SIM_OUT_END && _fifoEnabled()) {
+      reg = SIM_OUT; // roll over to the next FIFO sample
+    } else {
+      reg = (reg + 1) & 0x7F;
+    }
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Handles a register write transaction
+ *    @param  addr The address byte, with the chip's increment flag
+ *    @param  buffer The values written
+ *    @param  len The number of values
+ *    @param  spi True for SPI
+ *    @returns False if the transaction was NACKed
+ */
+bool LPS2XSim::write(uint8_t addr, const uint8_t *buffer, size_t len,
+                     bool spi) {
+  std::lock_guard<std::mutex> guard(_lock);
+  if (_fail(spi ? 1 : 2, len)) {
+    return false;
+  }
+  _run(lps2x_sim_clock);
+
+  uint8_t reg = addr & (spi ? 0x3F : 0x7F);
+  bool increment;
+  if (_isLPS22()) {
+    increment = _regs[lps22_map.ctrl2] & 0x10;
+  } else {
+    increment = addr & (spi ? 0x40 : 0x80);
+  }
+  for (size_t i = 0; i < len; i++) {
+    _writeReg(reg, buffer[i]);
+    if (increment) {
+      reg = (reg + 1) & 0x7F;
+    }
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Advances the virtual clock, converting every sample that falls
+ *            due and raising data ready for each
+ *    @param  us The time to advance by in microseconds
+ */
+void LPS2XSim::advance(uint32_t us) {
+  lps2x_sim_clock += us;
+  sync();
+}
+
+/*!
+ *    @brief  Converts every sample due by the current virtual time. Bus
+ *            transactions do this themselves
+ */
+void LPS2XSim::sync(void) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _run(lps2x_sim_clock);
+}
+
+/*!
+ *    @brief  Reads a register without any side effects
+ *    @param  reg The register address
+ *    @returns The register contents
+ */
+uint8_t LPS2XSim::peek(uint8_t reg) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _run(lps2x_sim_clock);
+  return _regs[reg & 0x7F];
+}
+
+/*!
+ *    @brief  Sets a register without any side effects, e.g. to fake a
+ *            configuration left over from an earlier boot
+ *    @param  reg The register address
+ *    @param  value The new contents
+ */
+void LPS2XSim::poke(uint8_t reg, uint8_t value) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _regs[reg & 0x7F] = value;
+}
+
+/*!
+ *    @brief  Zeroes the transaction, byte and conversion counters
+ */
+void LPS2XSim::resetCounters(void) {
+  std::lock_guard<std::mutex> guard(_lock);
+  transactions = 0;
+  bytes = 0;
+  conversions = 0;
+}
+
+/*!
+ *    @brief  Checks which chip is simulated
+ *    @returns True for the LPS22HB
+ */
+bool LPS2XSim::_isLPS22(void) { return _chip_id == SIM_CHIP_LPS22; }
+
+/*!
+ *    @brief  Gets the output data period of the current ODR
+ *    @returns The period in microseconds, 0 in one-shot mode
+ */
+uint32_t LPS2XSim::_period(void) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+  uint8_t odr = (_regs[map.ctrl1] >> 4) & 0x07;
+  return _isLPS22() ? lps22_periods[odr] : lps25_periods[odr];
+}
+
+/*!
+ *    @brief  Checks the LPS25 PD bit. The LPS22 has no power down bit
+ *    @returns True if the chip converts
+ */
+bool LPS2XSim::_powered(void) {
+  return _isLPS22() || (_regs[lps25_map.ctrl1] & 0x80);
+}
+
+/*!
+ *    @brief  Checks FIFO_EN and F_MODE
+ *    @returns True if samples go through the FIFO
+ */
+bool LPS2XSim::_fifoEnabled(void) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+  return (_regs[map.ctrl2] & 0x40) && (_regs[map.fifo_ctrl] & 0xE0);
+}
+
+/*!
+ *    @brief  Builds FIFO_STATUS from the FIFO state. The LPS25 has a five
+ *            bit level with an empty flag and reports a full FIFO as OVR
+ *    @returns The register value
+ */
+uint8_t LPS2XSim::_fifoStatusReg(void) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+  uint8_t watermark = _regs[map.fifo_ctrl] & 0x1F;
+  uint8_t status = (_fifo_level >= watermark && watermark) ? 0x80 : 0;
+  if (_isLPS22()) {
+    return status | (_fifo_ovr ? 0x40 : 0) | _fifo_level;
+  }
+  if (_fifo_level == 0) {
+    status |= 0x20;
+  }
+  if (_fifo_level == 32) {
+    status |= 0x40;
+  }
+  return status | (_fifo_level & 0x1F);
+}
+
+/*!
+ *    @brief  Reads one register with the side effects of a bus read
+ *    @param  reg The register address
+ *    @returns The register contents
+ */
+uint8_t LPS2XSim::_readReg(uint8_t reg) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+
+  if (reg == map.fifo_status) {
+    return _fifoStatusReg();
+  }
+  if (reg == SIM_INT_SOURCE) {
+    uint8_t value = _regs[reg];
+    if (_regs[map.int_cfg] & 0x04) { // LIR, reading clears the latch
+      _regs[reg] &= ~0x07;
+    }
+    return value;
+  }
+  if (reg < SIM_OUT || reg > SIM_OUT_END) {
+    return _regs[reg];
+  }
+
+  uint8_t value = _regs[reg];
+  if (_fifoEnabled() && _fifo_level) {
+    value = _fifo[_fifo_head][reg - SIM_OUT];
+    if (reg == SIM_OUT_END) {
+      _fifo_head = (_fifo_head + 1) % 32;
+      _fifo_level--;
+      _fifo_ovr = false;
+    }
+  }
+
+  // reading the high byte of an output clears its data available and
+  // overrun flags
+  uint8_t p_flags = _isLPS22() ? 0x11 : 0x22;
+  uint8_t t_flags = _isLPS22() ? 0x22 : 0x11;
+  if (reg == SIM_OUT + 2) {
+    _regs[SIM_STATUS] &= ~p_flags;
+  } else if (reg == SIM_OUT_END) {
+    _regs[SIM_STATUS] &= ~t_flags;
+  }
+  return value;
+}
+
+/*!
+ *    @brief  Writes one register with the side effects of a bus write
+ *    @param  reg The register address
+ *    @param  value The value written
+ */
+void LPS2XSim::_writeReg(uint8_t reg, uint8_t value) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+  uint64_t now = lps2x_sim_clock;
+
+  if (reg == SIM_WHOAMI || reg == SIM_STATUS || reg == SIM_INT_SOURCE ||
+      reg == map.fifo_status || (reg >= SIM_OUT && reg <= SIM_OUT_END)) {
+    return; // read only
+  }
+
+  if (reg == map.ctrl2) {
+    if (value & 0x04) { // SWRESET
+      _defaults();
+      if (hold_reset) {
+        _regs[map.ctrl2] |= 0x04;
+      }
+      return;
+    }
+    if (!_isLPS22() && (value & 0x02)) {
+      _capture_ref = true; // every AUTO_ZERO write captures again
+    }
+    _regs[reg] = value & ~0x01;
+    if ((value & 0x01) && _period() == 0 && _powered()) { // ONE_SHOT
+      _regs[reg] |= 0x01;
+      _oneshot = true;
+      _oneshot_done = now + oneshot_us;
+    }
+    return;
+  }
+
+  if (reg == map.int_cfg && _isLPS22()) {
+    if (value & 0x50) { // RESET_ARP, RESET_AZ
+      _regs[map.ref_p] = _regs[map.ref_p + 1] = _regs[map.ref_p + 2] = 0;
+      value &= ~0xF0;
+    }
+    if (value & 0xA0) { // AUTORIFP, AUTOZERO
+      _capture_ref = true;
+    }
+    _regs[reg] = value;
+    return;
+  }
+
+  if (reg == map.ctrl1) {
+    if (!_isLPS22() && (value & 0x02)) { // RESET_AZ
+      _regs[map.ref_p] = _regs[map.ref_p + 1] = _regs[map.ref_p + 2] = 0;
+      _regs[map.ctrl2] &= ~0x02;
+      value &= ~0x02;
+    }
+    uint32_t period = _period();
+    _regs[reg] = value;
+    if (_period() != period) {
+      _running = false; // a new rate restarts the conversion schedule
+    }
+    if (_period() && _powered()) {
+      _startContinuous(now);
+    } else {
+      _running = false;
+    }
+    return;
+  }
+
+  if (reg == map.fifo_ctrl && !(value & 0xE0)) {
+    _fifo_level = 0; // bypass empties the FIFO
+    _fifo_ovr = false;
+  }
+  _regs[reg] = value;
+}
+
+/*!
+ *    @brief  Sets the power on register values and stops conversions
+ */
+void LPS2XSim::_defaults(void) {
+  memset(_regs, 0, sizeof(_regs));
+  _regs[SIM_WHOAMI] = _chip_id;
+  if (_isLPS22()) {
+    _regs[lps22_map.ctrl2] = 0x10; // IF_ADD_INC
+  } else {
+    _regs[lps25_map.res_conf] = 0x05;
+  }
+  _fifo_head = 0;
+  _fifo_level = 0;
+  _fifo_ovr = false;
+  _oneshot = false;
+  _running = false;
+  _capture_ref = false;
+}
+
+/*!
+ *    @brief  Starts continuous conversions, unless already running. The
+ *            first sample is one output data period away
+ *    @param  now The current virtual time
+ */
+void LPS2XSim::_startContinuous(uint64_t now) {
+  if (_running) {
+    return;
+  }
+  _running = true;
+  _next = now + _period();
+}
+
+/*!
+ *    @brief  Converts every sample due by `now`
+ *    @param  now The virtual time to catch up to
+ */
+void LPS2XSim::_run(uint64_t now) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+
+  if (_oneshot && _oneshot_done <= now) {
+    _oneshot = false;
+    _regs[map.ctrl2] &= ~0x01;
+    _convert(_oneshot_done);
+  }
+  while (_running && _next <= now) {
+    _convert(_next);
+    _next += _period();
+  }
+}
+
+/*!
+ *    @brief  Converts one sample into the output registers and the FIFO
+ *    @param  when The conversion time
+ */
+void LPS2XSim::_convert(uint64_t when) {
+  const sim_map_t &map = _isLPS22() ? lps22_map : lps25_map;
+  float p = pressure, t = temperature;
+  if (waveform) {
+    waveform(when, &p, &t);
+  }
+  conversions++;
+
+  int32_t raw_p = (int32_t)lroundf(p * 4096);
+  int16_t rpds = (int16_t)(_regs[map.rpds] | _regs[map.rpds + 1] << 8);
+  raw_p -= rpds * 256;
+
+  int32_t ref = _regs[map.ref_p] | _regs[map.ref_p + 1] << 8 |
+                _regs[map.ref_p + 2] << 16;
+  if (ref & 0x800000) {
+    ref -= 0x1000000;
+  }
+  if (_capture_ref) {
+    ref = raw_p;
+    _regs[map.ref_p] = ref & 0xFF;
+    _regs[map.ref_p + 1] = (ref >> 8) & 0xFF;
+    _regs[map.ref_p + 2] = (ref >> 16) & 0xFF;
+    _capture_ref = false;
+  }
+
+  // threshold events compare against REF_P in 1/16 hPa steps
+  bool diff_en = _isLPS22() ? (_regs[map.int_cfg] & 0x08)
+                            : (_regs[map.ctrl1] & 0x08);
+  if (diff_en) {
+    int32_t diff = (raw_p - ref) / 256;
+    int32_t ths = _regs[map.ths_p] | _regs[map.ths_p + 1] << 8;
+    uint8_t source = 0;
+    if ((_regs[map.int_cfg] & 0x01) && diff > ths) {
+      source |= 0x01;
+    }
+    if ((_regs[map.int_cfg] & 0x02) && diff < -ths) {
+      source |= 0x02;
+    }
+    if (source) {
+      source |= 0x04;
+    }
+    if (_regs[map.int_cfg] & 0x04) {
+      _regs[SIM_INT_SOURCE] |= source;
+    } else {
+      _regs[SIM_INT_SOURCE] = (_regs[SIM_INT_SOURCE] & ~0x07) | source;
+    }
+  }
+
+  bool autozero = _isLPS22() ? (_regs[map.int_cfg] & 0x20)
+                             : (_regs[map.ctrl2] & 0x02);
+  if (autozero) {
+    raw_p -= ref;
+  }
+
+  int16_t raw_t;
+  if (_isLPS22()) {
+    raw_t = (int16_t)lroundf(t * 100);
+  } else {
+    raw_t = (int16_t)lroundf((t - 42.5f) * 480);
+  }
+
+  uint8_t record[5] = {(uint8_t)raw_p, (uint8_t)(raw_p >> 8),
+                       (uint8_t)(raw_p >> 16), (uint8_t)raw_t,
+                       (uint8_t)(raw_t >> 8)};
+  memcpy(&_regs[SIM_OUT], record, 5);
+
+  // a sample that replaces one never read sets the overrun flags
+  uint8_t status = _regs[SIM_STATUS];
+  uint8_t overrun = (status & 0x03) << 4;
+  _regs[SIM_STATUS] = (status & 0x30) | overrun | 0x03;
+
+  if (_fifoEnabled()) {
+    uint8_t mode = _regs[map.fifo_ctrl] >> 5;
+    uint8_t depth = 32;
+    if (_regs[map.ctrl2] & 0x20) { // STOP_ON_FTH
+      depth = _regs[map.fifo_ctrl] & 0x1F;
+    }
+    if (_fifo_level >= depth) {
+      if (mode == 1) { // FIFO mode stops when full
+        return;
+      }
+      _fifo_head = (_fifo_head + 1) % 32;
+      _fifo_level--;
+      _fifo_ovr = true;
+    }
+    memcpy(_fifo[(_fifo_head + _fifo_level) % 32], record, 5);
+    _fifo_level++;
+  }
+
+  if (on_drdy) {
+    on_drdy(when);
+  }
+}
+
+/*!
+ *    @brief  Counts a transaction and decides whether to NACK it
+ *    @param  overhead Address and register bytes on the bus
+ *    @param  len Data bytes
+ *    @returns True if the transaction fails
+ */
+bool LPS2XSim::_fail(size_t overhead, size_t len) {
+  transactions++;
+  bytes += overhead + len;
+  if (fail_all) {
+    return true;
+  }
+  if (fail_next) {
+    fail_next--;
+    return true;
+  }
+  return false;
+}
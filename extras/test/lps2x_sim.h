@@ -0,0 +1,98 @@
+/*!
+ *  @file lps2x_sim.h
+ *
+ * 	Register level simulator of the LPS22HB and LPS25HB for host tests. It
+ * 	models the register map, one-shot and continuous conversions on a
+ * 	virtual clock, the STATUS data available and overrun flags, the FIFO
+ * 	with its output register roll over, SWRESET, the pressure offset,
+ * 	autozero and the threshold events, and can inject bus faults
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_SIM_H
+#define _LPS2X_SIM_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+/** The virtual clock in microseconds shared by the simulator and the
+    Arduino stand-ins. `delay` advances it, so waits cost no real time */
+extern std::atomic<uint64_t> lps2x_sim_clock;
+
+/*!
+ *    @brief  One simulated sensor, attached to an I2C address or SPI chip
+ *            select so the BusIO stand-ins can find it
+ */
+class LPS2XSim {
+public:
+  LPS2XSim(uint8_t chip_id);
+  ~LPS2XSim(void);
+
+  void attachI2C(uint8_t address);
+  void attachSPI(int8_t cs_pin);
+  static LPS2XSim *findI2C(uint8_t address);
+  static LPS2XSim *findSPI(int8_t cs_pin);
+
+  bool read(uint8_t addr, uint8_t *buffer, size_t len, bool spi);
+  bool write(uint8_t addr, const uint8_t *buffer, size_t len, bool spi);
+
+  void advance(uint32_t us);
+  void sync(void);
+  uint8_t peek(uint8_t reg);
+  void poke(uint8_t reg, uint8_t value);
+  void resetCounters(void);
+
+  /** Pressure in hPa converted next, unless `waveform` is set */
+  float pressure = 1013.25f;
+  /** Temperature in C converted next, unless `waveform` is set */
+  float temperature = 25.0f;
+  /** Called before each conversion to set the pressure and temperature
+      from the conversion time in microseconds */
+  std::function<void(uint64_t, float *, float *)> waveform;
+  /** Called with the conversion time whenever a new sample lands in the
+      output registers or the FIFO, like a rising data ready line. Runs with
+      the simulator locked, so it must not access the bus */
+  std::function<void(uint64_t)> on_drdy;
+
+  uint32_t transactions = 0;  ///< Bus transactions, failed ones included
+  uint32_t bytes = 0;         ///< Bytes on the bus, counted like the driver
+  uint32_t conversions = 0;   ///< Samples converted
+  uint32_t fail_next = 0;     ///< Number of upcoming transactions to NACK
+  bool fail_all = false;      ///< NACK every transaction
+  bool hold_reset = false;    ///< Keep SWRESET set, as a wedged chip would
+  int16_t fail_read_reg = -1; ///< NACK reads starting at this register
+  uint32_t oneshot_us = 5000; ///< One-shot conversion time
+
+private:
+  bool _isLPS22(void);
+  uint32_t _period(void);
+  bool _powered(void);
+  bool _fifoEnabled(void);
+  uint8_t _fifoStatusReg(void);
+  uint8_t _readReg(uint8_t reg);
+  void _writeReg(uint8_t reg, uint8_t value);
+  void _defaults(void);
+  void _run(uint64_t now);
+  void _convert(uint64_t when);
+  void _startContinuous(uint64_t now);
+  bool _fail(size_t overhead, size_t len);
+
+  uint8_t _chip_id;
+  uint8_t _regs[128];
+  uint8_t _fifo[32][5];
+  uint8_t _fifo_head = 0;
+  uint8_t _fifo_level = 0;
+  bool _fifo_ovr = false;
+  uint64_t _next = 0;         // time of the next continuous conversion
+  uint64_t _oneshot_done = 0; // time a one-shot conversion completes
+  bool _oneshot = false;      // a one-shot conversion is in progress
+  bool _running = false;      // continuous conversions are scheduled
+  bool _capture_ref = false;  // autozero captures REF_P on the next sample
+  std::mutex _lock;
+};
+
+#endif
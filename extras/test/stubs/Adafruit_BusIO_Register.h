@@ -0,0 +1,16 @@
+/*!
+ *  @file Adafruit_BusIO_Register.h
+ *
+ * 	The driver accesses registers through the devices directly, so this
+ * 	only pulls them in
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_BUSIO_REGISTER_H
+#define _LPS2X_TEST_BUSIO_REGISTER_H
+
+#include "Adafruit_I2CDevice.h"
+#include "Adafruit_SPIDevice.h"
+
+#endif
@@ -0,0 +1,62 @@
+/*!
+ *  @file Adafruit_I2CDevice.h
+ *
+ * 	BusIO I2C device that talks to the simulator attached at its address
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_I2CDEVICE_H
+#define _LPS2X_TEST_I2CDEVICE_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+/** An I2C device on the simulated bus */
+class Adafruit_I2CDevice {
+public:
+  /** @brief Creates the device
+      @param addr The 7-bit address
+      @param theWire Unused */
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire) {
+    (void)theWire;
+    _addr = addr;
+  }
+
+  /** @brief Checks that a chip acknowledges the address
+      @returns True if a simulator is attached there */
+  bool begin(bool addr_detect = true) {
+    (void)addr_detect;
+    return LPS2XSim::findI2C(_addr) != NULL;
+  }
+
+  /** @brief Writes a prefix and data in one transaction
+      @returns True on ACK */
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    (void)stop;
+    LPS2XSim *sim = LPS2XSim::findI2C(_addr);
+    if (!sim || prefix_len != 1) {
+      return false;
+    }
+    return sim->write(prefix_buffer[0], buffer, len, false);
+  }
+
+  /** @brief Writes the register address, then reads with a repeated start
+      @returns True on ACK */
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false) {
+    (void)stop;
+    LPS2XSim *sim = LPS2XSim::findI2C(_addr);
+    if (!sim || write_len != 1) {
+      return false;
+    }
+    return sim->read(write_buffer[0], read_buffer, read_len, false);
+  }
+
+private:
+  uint8_t _addr;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*!
+ *  @file Adafruit_SPIDevice.h
+ *
+ * 	BusIO SPI device that talks to the simulator on its chip select
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_SPIDEVICE_H
+#define _LPS2X_TEST_SPIDEVICE_H
+
+#include "Arduino.h"
+#include "SPI.h"
+
+/** Bit order of SPI transfers */
+typedef enum {
+  SPI_BITORDER_MSBFIRST,
+  SPI_BITORDER_LSBFIRST,
+} BusIOBitOrder;
+
+/** An SPI device on the simulated bus */
+class Adafruit_SPIDevice {
+public:
+  /** @brief Creates a hardware SPI device
+      @param cspin The chip select pin */
+  Adafruit_SPIDevice(int8_t cspin, uint32_t = 1000000,
+                     BusIOBitOrder = SPI_BITORDER_MSBFIRST, uint8_t = SPI_MODE0,
+                     SPIClass * = &SPI) {
+    _cs = cspin;
+  }
+
+  /** @brief Creates a bit banged SPI device
+      @param cspin The chip select pin */
+  Adafruit_SPIDevice(int8_t cspin, int8_t, int8_t, int8_t, uint32_t = 1000000,
+                     BusIOBitOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t = SPI_MODE0) {
+    _cs = cspin;
+  }
+
+  /** @brief SPI has no acknowledge, so this always succeeds
+      @returns True */
+  bool begin(void) { return true; }
+
+  /** @brief Writes a prefix and data with CS held
+      @returns True unless the simulator rejected the transfer */
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    LPS2XSim *sim = LPS2XSim::findSPI(_cs);
+    if (!sim || prefix_len != 1) {
+      return false;
+    }
+    return sim->write(prefix_buffer[0], buffer, len, true);
+  }
+
+  /** @brief Writes the address byte, then reads with CS held
+      @returns True unless the simulator rejected the transfer */
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       uint8_t sendvalue = 0xFF) {
+    (void)sendvalue;
+    LPS2XSim *sim = LPS2XSim::findSPI(_cs);
+    if (!sim || write_len != 1) {
+      return false;
+    }
+    return sim->read(write_buffer[0], read_buffer, read_len, true);
+  }
+
+private:
+  int8_t _cs;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*!
+ *  @file Adafruit_Sensor.h
+ *
+ * 	The Unified Sensor types the driver uses
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_SENSOR_H
+#define _LPS2X_TEST_SENSOR_H
+
+#include <stdint.h>
+
+#define SENSOR_TYPE_PRESSURE 6             ///< Pressure in hPa
+#define SENSOR_TYPE_AMBIENT_TEMPERATURE 13 ///< Temperature in C
+
+/** Unified Sensor event */
+typedef struct {
+  int32_t version;   ///< must be sizeof(struct sensors_event_t)
+  int32_t sensor_id; ///< unique sensor identifier
+  int32_t type;      ///< sensor type
+  int32_t reserved0; ///< reserved
+  int32_t timestamp; ///< time is in milliseconds
+  union {
+    float data[4];     ///< Raw data
+    float temperature; ///< temperature is in degrees centigrade (Celsius)
+    float pressure;    ///< pressure in hectopascal (hPa)
+  };                   ///< Union for the sensor data
+} sensors_event_t;
+
+/** Unified Sensor details */
+typedef struct {
+  char name[12];     ///< sensor name
+  int32_t version;   ///< version of the hardware + driver
+  int32_t sensor_id; ///< unique sensor identifier
+  int32_t type;      ///< this sensor's type (ex. SENSOR_TYPE_LIGHT)
+  float max_value;   ///< maximum value of this sensor's value in SI units
+  float min_value;   ///< minimum value of this sensor's value in SI units
+  float resolution;  ///< smallest difference between two values
+  int32_t min_delay; ///< min delay in microseconds between events
+} sensor_t;
+
+/** Unified Sensor interface */
+class Adafruit_Sensor {
+public:
+  virtual ~Adafruit_Sensor() {}
+  /** @brief Gets the latest sensor event
+      @returns True if the event was read */
+  virtual bool getEvent(sensors_event_t *) = 0;
+  /** @brief Gets the sensor's details */
+  virtual void getSensor(sensor_t *) = 0;
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*!
+ *  @file Arduino.h
+ *
+ * 	The parts of the Arduino core the driver uses, on the simulator's
+ * 	virtual clock
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_ARDUINO_H
+#define _LPS2X_TEST_ARDUINO_H
+
+#include "lps2x_sim.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** @returns The virtual time in microseconds */
+inline uint32_t micros(void) { return (uint32_t)lps2x_sim_clock; }
+
+/** @returns The virtual time in milliseconds */
+inline uint32_t millis(void) { return (uint32_t)(lps2x_sim_clock / 1000); }
+
+/** @brief Advances the virtual clock
+    @param ms The time in milliseconds */
+inline void delay(uint32_t ms) { lps2x_sim_clock += (uint64_t)ms * 1000; }
+
+/** @brief Advances the virtual clock
+    @param us The time in microseconds */
+inline void delayMicroseconds(uint32_t us) { lps2x_sim_clock += us; }
+
+/** @brief Host threads stand in for interrupts, so there is nothing to mask */
+inline void noInterrupts(void) {}
+
+/** @brief Counterpart of `noInterrupts` */
+inline void interrupts(void) {}
+
+#define LSBFIRST 0 ///< Bit order
+#define MSBFIRST 1 ///< Bit order
+
+#endif
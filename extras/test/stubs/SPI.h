@@ -0,0 +1,19 @@
+/*!
+ *  @file SPI.h
+ *
+ * 	SPI bus placeholder; the BusIO stand-ins route to the simulator
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_SPI_H
+#define _LPS2X_TEST_SPI_H
+
+#define SPI_MODE0 0 ///< Clock idle low, sample on the rising edge
+
+/** An SPI bus */
+class SPIClass {};
+
+extern SPIClass SPI; ///< The default SPI bus
+
+#endif
@@ -0,0 +1,17 @@
+/*!
+ *  @file Wire.h
+ *
+ * 	I2C bus placeholder; the BusIO stand-ins route to the simulator
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_WIRE_H
+#define _LPS2X_TEST_WIRE_H
+
+/** An I2C bus */
+class TwoWire {};
+
+extern TwoWire Wire; ///< The default I2C bus
+
+#endif
@@ -0,0 +1,13 @@
+/*!
+ *  @file stubs.cpp
+ *
+ * 	The default buses of the Arduino stand-ins
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "SPI.h"
+#include "Wire.h"
+
+TwoWire Wire;
+SPIClass SPI;
@@ -0,0 +1,141 @@
+/*!
+ *  @file test_calibration.cpp
+ *
+ * 	Pressure offset calibration, its stored blob and the RPDS register it
+ * 	lands in, on the simulated chips
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include "test_common.h"
+#include <Adafruit_LPS2X.h>
+
+/** Reads the offset the simulated LPS22 applies, 16 LSB/hPa */
+static int16_t sim_rpds(LPS2XSim *sim) {
+  return (int16_t)(sim->peek(LPS22_RPDS_L + 1) << 8 | sim->peek(LPS22_RPDS_L));
+}
+
+/** Calibrating against a reference lands the error in RPDS */
+static void test_calibrate_writes_rpds(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.pressure = 1000.0f;
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  CHECK(lps.calibrate(998.0f, 4));
+  CHECK(sim_rpds(&sim) == 2 * 16);
+
+  sensors_event_t pressure, temp;
+  sim.advance(40000);
+  CHECK(lps.getEvent(&pressure, &temp));
+  CHECK_NEAR(pressure.pressure, 998.0, 1.0 / 4096);
+}
+
+/** The offset follows the temperature, and only moves RPDS when it must */
+static void test_temperature_compensation(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.temperature = 20.0f;
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  CHECK(lps.setPressureOffset(1.0f));
+  CHECK(sim_rpds(&sim) == 16);
+  lps.setTemperatureCoefficient(0.1f);
+
+  sensors_event_t pressure, temp;
+  sim.advance(40000);
+  CHECK(lps.getEvent(&pressure, &temp));
+  CHECK(lps.updateTemperatureCompensation());
+  CHECK(sim_rpds(&sim) == 3 * 16); // 1 + 0.1 * 20
+
+  sim.resetCounters();
+  CHECK(lps.updateTemperatureCompensation());
+  CHECK(sim.transactions == 0); // unchanged, not rewritten
+}
+
+/** A stored calibration is restored, even at the clamped maximum offset */
+static void test_load_calibration(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  CHECK(lps.setPressureOffset(4000.0f));
+  CHECK(sim_rpds(&sim) == 32767);
+  uint8_t blob[LPS2X_CALIBRATION_SIZE];
+  lps.saveCalibration(blob);
+
+  sim.poke(LPS22_RPDS_L, 0); // lost behind the driver's back
+  sim.poke(LPS22_RPDS_L + 1, 0);
+  CHECK(lps.loadCalibration(blob));
+  CHECK(sim_rpds(&sim) == 32767);
+}
+
+/** A blob that fails its Fletcher-16 checksum is not applied */
+static void test_load_calibration_checksum(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  CHECK(lps.setPressureOffset(2.0f));
+  uint8_t blob[LPS2X_CALIBRATION_SIZE];
+  lps.saveCalibration(blob);
+  CHECK(lps.setPressureOffset(0.0f));
+
+  blob[3] ^= 0x01; // the offset
+  CHECK(!lps.loadCalibration(blob));
+  blob[3] ^= 0x01;
+  blob[LPS2X_CALIBRATION_SIZE - 1] ^= 0x01; // the checksum
+  CHECK(!lps.loadCalibration(blob));
+  CHECK(sim_rpds(&sim) == 0);
+
+  blob[LPS2X_CALIBRATION_SIZE - 1] ^= 0x01;
+  CHECK(lps.loadCalibration(blob));
+  CHECK(sim_rpds(&sim) == 2 * 16);
+}
+
+/** A blob saved on one chip is not applied to the other */
+static void test_load_calibration_wrong_chip(void) {
+  LPS2XSim sim22(LPS22HB_CHIP_ID), sim25(LPS25HB_CHIP_ID);
+  sim22.attachI2C(0x5C);
+  sim25.attachI2C(0x5D);
+
+  Adafruit_LPS22 lps22;
+  Adafruit_LPS25 lps25;
+  CHECK(lps22.begin_I2C(0x5C));
+  CHECK(lps25.begin_I2C(0x5D));
+  CHECK(lps22.setPressureOffset(2.0f));
+  uint8_t blob[LPS2X_CALIBRATION_SIZE];
+  lps22.saveCalibration(blob);
+
+  CHECK(!lps25.loadCalibration(blob));
+  CHECK(sim25.peek(LPS25_RPDS_L) == 0 && sim25.peek(LPS25_RPDS_L + 1) == 0);
+}
+
+/** With fast init the driver learns the offset the chip already applies */
+static void test_fast_init_reads_rpds(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.poke(LPS22_RPDS_L, 32); // left by an earlier run
+
+  Adafruit_LPS22 lps;
+  lps.setFastInit(true);
+  CHECK(lps.begin_I2C());
+  CHECK_NEAR(lps.getPressureOffset(), 2.0, 1e-6);
+  CHECK(lps.setPressureOffset(0.0f));
+  CHECK(sim_rpds(&sim) == 0);
+}
+
+int main(void) {
+  RUN(test_calibrate_writes_rpds);
+  RUN(test_temperature_compensation);
+  RUN(test_load_calibration);
+  RUN(test_load_calibration_checksum);
+  RUN(test_load_calibration_wrong_chip);
+  RUN(test_fast_init_reads_rpds);
+  return test_summary();
+}
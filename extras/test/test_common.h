@@ -0,0 +1,55 @@
+/*!
+ *  @file test_common.h
+ *
+ * 	Minimal checks shared by the host tests
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _LPS2X_TEST_COMMON_H
+#define _LPS2X_TEST_COMMON_H
+
+#include <math.h>
+#include <stdio.h>
+
+static int test_failures = 0; ///< Failed checks in this test program
+
+/** Records a failure if `cond` is false */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+/** Records a failure if `a` and `b` differ by more than `tol` */
+#define CHECK_NEAR(a, b, tol)                                                  \
+  do {                                                                         \
+    double _a = (a), _b = (b);                                                 \
+    if (fabs(_a - _b) > (tol)) {                                               \
+      printf("%s:%d: CHECK_NEAR(%s, %s) failed: %f vs %f\n", __FILE__,         \
+             __LINE__, #a, #b, _a, _b);                                        \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+/** Runs one test function */
+#define RUN(test)                                                              \
+  do {                                                                         \
+    printf("%s\n", #test);                                                     \
+    test();                                                                    \
+  } while (0)
+
+/** Prints the summary
+    @returns The exit status for `main` */
+static inline int test_summary(void) {
+  if (test_failures) {
+    printf("%d check(s) failed\n", test_failures);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
+
+#endif
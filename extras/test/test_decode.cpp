@@ -0,0 +1,82 @@
+/*!
+ *  @file test_decode.cpp
+ *
+ * 	The batch decoder against the scalar one, for every tail length and
+ * 	the extremes of both fields. The Makefile also builds this with
+ * 	-mssse3 on x86, so both the shuffle path and the word path are checked
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "test_common.h"
+#include <Adafruit_LPS2X_Decode.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSSE3__)
+static const char *path = "ssse3"; ///< The batch path under test
+#else
+static const char *path = "portable"; ///< The batch path under test
+#endif
+
+static const size_t max_records = 67; ///< Several blocks of four plus a tail
+
+/** Decodes `count` records both ways and compares the floats bit for bit */
+static void check_same(const uint8_t *records, size_t count, float scale,
+                       float offset) {
+  float p_scalar[max_records], t_scalar[max_records];
+  float p_batch[max_records], t_batch[max_records];
+  lps2x_decode_records_scalar(records, count, scale, offset, p_scalar,
+                              t_scalar);
+  lps2x_decode_records(records, count, scale, offset, p_batch, t_batch);
+  CHECK(!memcmp(p_scalar, p_batch, count * sizeof(float)));
+  CHECK(!memcmp(t_scalar, t_batch, count * sizeof(float)));
+}
+
+/** Random records match for every count, including the tails */
+static void test_decode_random_records(void) {
+  uint8_t records[max_records * LPS2X_RECORD_SIZE];
+  srand(1);
+  for (size_t i = 0; i < sizeof(records); i++) {
+    records[i] = (uint8_t)rand();
+  }
+  for (size_t count = 0; count <= max_records; count++) {
+    check_same(records, count, LPS22_TEMP_SCALE, LPS22_TEMP_OFFSET);
+    check_same(records, count, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET);
+  }
+}
+
+/** The sign extension holds at both ends of each field */
+static void test_decode_extremes(void) {
+  const uint8_t edges[8][LPS2X_RECORD_SIZE] = {
+      {0x00, 0x00, 0x80, 0x00, 0x80}, // most negative
+      {0xFF, 0xFF, 0x7F, 0xFF, 0x7F}, // most positive
+      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, // -1
+      {0x00, 0x00, 0x00, 0x00, 0x00}, // 0
+      {0x01, 0x00, 0x00, 0x01, 0x00}, // 1
+      {0x00, 0x00, 0x80, 0xFF, 0x7F}, // mixed signs
+      {0xFF, 0xFF, 0x7F, 0x00, 0x80},
+      {0x00, 0x80, 0x3E, 0x2C, 0x01}, // 1000 hPa, 3 C on the LPS22
+  };
+  float pressure[8], temperature[8];
+  lps2x_decode_records(&edges[0][0], 8, LPS22_TEMP_SCALE, LPS22_TEMP_OFFSET,
+                       pressure, temperature);
+  CHECK(pressure[0] == -2048.0f);
+  CHECK_NEAR(temperature[0], -327.68, 1e-4);
+  CHECK(pressure[1] == 8388607 / 4096.0f);
+  CHECK_NEAR(temperature[1], 327.67, 1e-4);
+  CHECK(pressure[2] == -1 / 4096.0f);
+  CHECK_NEAR(temperature[2], -0.01, 1e-6);
+  CHECK(pressure[3] == 0 && temperature[3] == 0);
+  CHECK_NEAR(pressure[7], 1000.0, 1e-4);
+  CHECK_NEAR(temperature[7], 3.0, 1e-4);
+  check_same(&edges[0][0], 8, LPS22_TEMP_SCALE, LPS22_TEMP_OFFSET);
+  check_same(&edges[0][0], 8, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET);
+}
+
+int main(void) {
+  printf("batch path: %s\n", path);
+  RUN(test_decode_random_records);
+  RUN(test_decode_extremes);
+  return test_summary();
+}
@@ -0,0 +1,260 @@
+/*!
+ *  @file test_errors.cpp
+ *
+ * 	Recovery of the non-blocking paths from bus errors and conversions that
+ * 	never finish, on the simulated chips
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include "test_common.h"
+#include <Adafruit_LPS2X.h>
+#include <Adafruit_LPS2X_Fast.h>
+
+/** A failed ONE_SHOT write is not left pending */
+static void test_poll_retries_failed_start(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_ONE_SHOT);
+
+  sensors_event_t pressure, temp;
+  sim.fail_next = 1;
+  CHECK(!lps.startMeasurement());
+  CHECK(!lps.poll(&pressure, &temp)); // starts it again
+  sim.advance(10000);
+  CHECK(lps.poll(&pressure, &temp));
+}
+
+/** A conversion that never finishes is given up and restarted */
+static void test_poll_times_out_lost_conversion(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_ONE_SHOT);
+  lps.resetBusStats();
+
+  sensors_event_t pressure, temp;
+  sim.oneshot_us = 1000000000; // lost
+  CHECK(!lps.poll(&pressure, &temp));
+  sim.advance(50000);
+  CHECK(!lps.poll(&pressure, &temp));
+
+  sim.oneshot_us = 5000;
+  sim.advance(LPS2X_TIMEOUT_MS * 1000);
+  CHECK(!lps.poll(&pressure, &temp)); // gives up and starts over
+  lps2x_bus_stats_t stats;
+  lps.getBusStats(&stats);
+  CHECK(stats.timeouts == 1);
+
+  sim.advance(10000);
+  CHECK(lps.poll(&pressure, &temp));
+}
+
+/** A failed wake is retried on the next interval instead of stalling */
+static void test_duty_cycle_retries_failed_wake(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDutyCycle(1000);
+
+  sensors_event_t pressure, temp;
+  sim.fail_next = 1; // the ONE_SHOT write
+  CHECK(!lps.updateDutyCycle(&pressure, &temp));
+  sim.advance(10000);
+  CHECK(!lps.updateDutyCycle(&pressure, &temp)); // not awake, not due
+
+  sim.advance(1000000);
+  CHECK(!lps.updateDutyCycle(&pressure, &temp)); // wakes
+  sim.advance(10000);
+  CHECK(lps.updateDutyCycle(&pressure, &temp));
+}
+
+/** A conversion that never finishes powers the LPS25 back down */
+static void test_duty_cycle_times_out_lost_conversion(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS25 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDutyCycle(1000);
+  lps.resetBusStats();
+
+  sensors_event_t pressure, temp;
+  sim.oneshot_us = 1000000000; // lost
+  CHECK(!lps.updateDutyCycle(&pressure, &temp));
+  CHECK(sim.peek(LPS25_CTRL_REG1) & 0x80); // awake
+  sim.advance(LPS2X_TIMEOUT_MS * 1000);
+  CHECK(!lps.updateDutyCycle(&pressure, &temp));
+  CHECK(!(sim.peek(LPS25_CTRL_REG1) & 0x80)); // powered down again
+
+  lps2x_bus_stats_t stats;
+  lps.getBusStats(&stats);
+  CHECK(stats.timeouts == 1);
+
+  sim.oneshot_us = 5000;
+  sim.advance(1000000);
+  CHECK(!lps.updateDutyCycle(&pressure, &temp));
+  sim.advance(10000);
+  CHECK(lps.updateDutyCycle(&pressure, &temp));
+}
+
+/** Turning duty cycling off leaves the LPS25 powered for one-shot reads */
+static void test_duty_cycle_off_powers_up(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS25 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDutyCycle(1000);
+  CHECK(!(sim.peek(LPS25_CTRL_REG1) & 0x80));
+  lps.setDutyCycle(0);
+  CHECK(sim.peek(LPS25_CTRL_REG1) & 0x80);
+
+  sensors_event_t pressure, temp;
+  CHECK(lps.getEvent(&pressure, &temp));
+}
+
+/** A stalled loop gets one sample afterwards, not one per missed interval */
+static void test_duty_cycle_resyncs_after_stall(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDutyCycle(1000);
+
+  sensors_event_t pressure, temp;
+  CHECK(!lps.updateDutyCycle(&pressure, &temp)); // wakes
+  sim.advance(10000);
+  CHECK(lps.updateDutyCycle(&pressure, &temp));
+
+  sim.advance(60ul * 60 * 1000000); // an hour of blocking code
+  uint32_t samples = 0;
+  sim.resetCounters();
+  for (uint32_t i = 0; i < 100; i++) { // one second of 10 ms loops
+    sim.advance(10000);
+    if (lps.updateDutyCycle(&pressure, &temp)) {
+      samples++;
+    }
+  }
+  CHECK(samples == 1);
+  CHECK(sim.conversions == 1);
+}
+
+/** A failed raw or fixed point read leaves the caller's values alone */
+static void test_failed_raw_read_writes_nothing(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  sim.advance(40000);
+
+  lps2x_raw_sample_t raw = {1, 2, 3};
+  int32_t pressure = 4;
+  int16_t temp = 5;
+  sim.fail_all = true;
+  CHECK(!lps.readRaw(&raw));
+  CHECK(!lps.readFixed(&pressure, &temp));
+  CHECK(raw.timestamp == 1 && raw.pressure == 2 && raw.temperature == 3);
+  CHECK(pressure == 4 && temp == 5);
+}
+
+/** A STATUS read that fails ends the one-shot wait as a bus error, not a
+    timeout */
+static void test_status_error_is_not_a_timeout(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_ONE_SHOT);
+  lps.resetBusStats();
+
+  sensors_event_t pressure, temp;
+  sim.fail_read_reg = LPS2X_STATUS;
+  uint32_t start = millis();
+  CHECK(!lps.getEvent(&pressure, &temp));
+  CHECK(millis() - start < LPS2X_TIMEOUT_MS);
+  CHECK(!lps.isMeasurementReady());
+  lps2x_bus_stats_t stats;
+  lps.getBusStats(&stats);
+  CHECK(stats.timeouts == 0);
+
+  sim.fail_read_reg = -1;
+  CHECK(lps.getEvent(&pressure, &temp));
+}
+
+/** A failed FIFO_STATUS read drains nothing */
+static void test_fifo_level_error(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS25 lps;
+  CHECK(lps.begin_I2C());
+  lps.setFifoMode(LPS25_FIFO_STREAM);
+  sim.advance(10 * 40000);
+  CHECK(lps.getFifoLevel() > 0);
+
+  lps2x_sample_t samples[LPS2X_FIFO_DEPTH];
+  sim.fail_read_reg = LPS25_FIFO_STATUS;
+  sim.resetCounters();
+  CHECK(lps.getFifoLevel() == 0);
+  CHECK(lps.readFifo(samples, LPS2X_FIFO_DEPTH) == 0);
+  CHECK(sim.transactions == 2); // no burst read after the failed level
+
+  sim.fail_read_reg = -1;
+  CHECK(lps.readFifo(samples, LPS2X_FIFO_DEPTH) > 0);
+}
+
+/** Fast init fails if the running configuration cannot be read back */
+static void test_fast_init_shadow_error(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  lps.setFastInit(true);
+  sim.fail_read_reg = LPS22_FIFO_CTRL;
+  CHECK(!lps.begin_I2C());
+  sim.fail_read_reg = -1;
+  CHECK(lps.begin_I2C());
+}
+
+/** The compile time driver gives up on a reset that never finishes */
+static void test_fast_begin_bounds_reset(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS2X_Fast<LPS2X_Chip22, LPS2X_BusI2C> lps(LPS2X_I2CADDR_DEFAULT,
+                                                      &Wire);
+  sim.hold_reset = true;
+  uint32_t start = millis();
+  CHECK(!lps.begin());
+  CHECK(millis() - start <= LPS2X_TIMEOUT_MS + 2);
+
+  sim.hold_reset = false;
+  CHECK(lps.begin());
+}
+
+int main(void) {
+  RUN(test_poll_retries_failed_start);
+  RUN(test_poll_times_out_lost_conversion);
+  RUN(test_duty_cycle_retries_failed_wake);
+  RUN(test_duty_cycle_times_out_lost_conversion);
+  RUN(test_duty_cycle_off_powers_up);
+  RUN(test_duty_cycle_resyncs_after_stall);
+  RUN(test_failed_raw_read_writes_nothing);
+  RUN(test_status_error_is_not_a_timeout);
+  RUN(test_fifo_level_error);
+  RUN(test_fast_init_shadow_error);
+  RUN(test_fast_begin_bounds_reset);
+  return test_summary();
+}
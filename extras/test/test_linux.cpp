@@ -0,0 +1,169 @@
+/*!
+ *  @file test_linux.cpp
+ *
+ * 	The Linux i2c-dev and spidev transports, built without an Arduino core.
+ * 	The nodes are /dev/null and the link wraps ioctl, so every I2C_RDWR and
+ * 	SPI_IOC_MESSAGE goes to the simulated chips and can be counted
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include "test_common.h"
+#include <Adafruit_LPS2X_Linux.h>
+#include <linux/i2c-dev.h>
+#include <linux/spi/spidev.h>
+#include <stdarg.h>
+
+static uint32_t ioctls = 0;            ///< Calls that reached the kernel
+static LPS2XSim *spidev_sim = NULL;    ///< The chip behind the spidev node
+static const char *node = "/dev/null"; ///< Opened as both nodes
+
+/** A program's own Arduino shim, which the public headers must leave room
+    for. The library's sources keep their clock to themselves */
+uint32_t millis(void) { return 0; }
+void delay(uint32_t) {}
+
+/** Replaces ioctl for the transports, linked with --wrap=ioctl */
+extern "C" int __wrap_ioctl(int fd, unsigned long request, ...) {
+  va_list args;
+  va_start(args, request);
+  void *arg = va_arg(args, void *);
+  va_end(args);
+  (void)fd;
+  ioctls++;
+
+  if (request == I2C_RDWR) {
+    struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+    for (uint32_t i = 0; i < data->nmsgs; i++) {
+      struct i2c_msg *msg = &data->msgs[i];
+      LPS2XSim *sim = LPS2XSim::findI2C(msg->addr);
+      if (!sim) {
+        return -1;
+      }
+      bool ok;
+      if (i + 1 < data->nmsgs && (data->msgs[i + 1].flags & I2C_M_RD)) {
+        // address write and data read with a repeated start
+        struct i2c_msg *rd = &data->msgs[++i];
+        ok = sim->read(msg->buf[0], rd->buf, rd->len, false);
+      } else {
+        ok = sim->write(msg->buf[0], msg->buf + 1, msg->len - 1, false);
+      }
+      if (!ok) {
+        return -1;
+      }
+    }
+    return data->nmsgs;
+  }
+
+  if (request == SPI_IOC_MESSAGE(2)) {
+    struct spi_ioc_transfer *xfer = (struct spi_ioc_transfer *)arg;
+    uint8_t addr = *(uint8_t *)(uintptr_t)xfer[0].tx_buf;
+    uint8_t *rx = (uint8_t *)(uintptr_t)xfer[1].rx_buf;
+    const uint8_t *tx = (const uint8_t *)(uintptr_t)xfer[1].tx_buf;
+    bool ok;
+    if (rx) {
+      ok = spidev_sim->read(addr, rx, xfer[1].len, true);
+    } else {
+      ok = spidev_sim->write(addr, tx, xfer[1].len, true);
+    }
+    return ok ? (int)(xfer[0].len + xfer[1].len) : -1;
+  }
+
+  return 0; // SPI mode, word size and clock
+}
+
+/** A sample on i2c-dev costs one ioctl */
+static void test_i2c_event_is_one_ioctl(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.pressure = 1002.5f;
+  sim.temperature = 18.5f;
+
+  Adafruit_LPS2X_LinuxI2C bus(node);
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_Transport(&bus));
+  sim.advance(40000);
+
+  sensors_event_t pressure, temp;
+  ioctls = 0;
+  sim.resetCounters();
+  CHECK(lps.getEvent(&pressure, &temp));
+  CHECK(ioctls == 1);
+  CHECK(sim.transactions == 1);
+  CHECK_NEAR(pressure.pressure, 1002.5, 1.0 / 4096);
+  CHECK_NEAR(temp.temperature, 18.5, 0.01);
+}
+
+/** A sample on spidev costs one ioctl, with the LPS25 increment bit */
+static void test_spi_event_is_one_ioctl(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  spidev_sim = &sim;
+  sim.pressure = 995.0f;
+  sim.temperature = 30.0f;
+
+  Adafruit_LPS2X_LinuxSPI bus(node);
+  Adafruit_LPS25 lps;
+  CHECK(lps.begin_Transport(&bus));
+  sim.advance(40000);
+
+  sensors_event_t pressure, temp;
+  ioctls = 0;
+  CHECK(lps.getEvent(&pressure, &temp));
+  CHECK(ioctls == 1);
+  CHECK_NEAR(pressure.pressure, 995.0, 1.0 / 4096);
+  CHECK_NEAR(temp.temperature, 30.0, 1.0 / 480);
+  spidev_sim = NULL;
+}
+
+/** A batch reads every sensor on the bus in one ioctl */
+static void test_batch_is_one_ioctl(void) {
+  LPS2XSim sim_a(LPS22HB_CHIP_ID), sim_b(LPS22HB_CHIP_ID);
+  sim_a.attachI2C(0x5C);
+  sim_b.attachI2C(0x5D);
+  sim_a.pressure = 1000.0f;
+  sim_b.pressure = 1010.0f;
+
+  Adafruit_LPS2X_LinuxI2C bus_a(node, 0x5C), bus_b(node, 0x5D);
+  Adafruit_LPS22 lps_a, lps_b;
+  CHECK(lps_a.begin_Transport(&bus_a));
+  CHECK(lps_b.begin_Transport(&bus_b));
+
+  Adafruit_LPS2X_LinuxI2CBatch batch;
+  CHECK(batch.add(&lps_a, &bus_a));
+  CHECK(batch.add(&lps_b, &bus_b));
+
+  CHECK(batch.update() == 0); // no new samples yet
+  sim_a.advance(40000);        // the clock is shared, so both convert
+  sim_b.sync();
+  ioctls = 0;
+  CHECK(batch.update() == 2);
+  CHECK(ioctls == 1);
+  CHECK(batch.updated == 0x03);
+  CHECK_NEAR(batch.pressure[0], 1000.0, 1.0 / 4096);
+  CHECK_NEAR(batch.pressure[1], 1010.0, 1.0 / 4096);
+}
+
+/** A NACK fails the read without touching the bus again */
+static void test_i2c_nack(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS2X_LinuxI2C bus(node);
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_Transport(&bus));
+
+  sensors_event_t pressure, temp;
+  sim.fail_all = true;
+  ioctls = 0;
+  CHECK(!lps.getEvent(&pressure, &temp));
+  CHECK(ioctls == 1);
+}
+
+int main(void) {
+  RUN(test_i2c_event_is_one_ioctl);
+  RUN(test_spi_event_is_one_ioctl);
+  RUN(test_batch_is_one_ioctl);
+  RUN(test_i2c_nack);
+  return test_summary();
+}
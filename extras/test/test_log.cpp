@@ -0,0 +1,206 @@
+/*!
+ *  @file test_log.cpp
+ *
+ * 	The binary log format, written and read back in memory
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "test_common.h"
+#include <Adafruit_LPS2X.h>
+#include <Adafruit_LPS2X_Log.h>
+#include <vector>
+
+static const uint32_t period_us = 40000; ///< 25 Hz
+
+/** Appends the writer's bytes to a vector */
+static bool to_vector(const uint8_t *data, size_t len, void *context) {
+  std::vector<uint8_t> *log = (std::vector<uint8_t> *)context;
+  log->insert(log->end(), data, data + len);
+  return true;
+}
+
+/** Refuses every write */
+static bool to_nowhere(const uint8_t *, size_t, void *) { return false; }
+
+/** The raw pressure logged for sample `i` */
+static int32_t press_of(uint32_t i) { return 4096 * 1000 + (int32_t)i * 7; }
+
+/** The raw temperature logged for sample `i`, negative ones included */
+static int16_t temp_of(uint32_t i) { return (int16_t)(i * 480 - 9600); }
+
+/** Writes `count` LPS25 samples one period apart, starting at `start` */
+static void write_log(std::vector<uint8_t> *log, uint32_t start,
+                      uint32_t count) {
+  Adafruit_LPS2X_LogWriter writer(to_vector, log);
+  CHECK(writer.begin(LPS25HB_CHIP_ID, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET,
+                     period_us));
+  for (uint32_t i = 0; i < count; i++) {
+    CHECK(writer.add(start + i * period_us, press_of(i), temp_of(i)));
+  }
+  CHECK(writer.flush());
+}
+
+/** Checks the records of a block are samples `first` onwards */
+static void check_records(const lps2x_log_block_t *block, uint32_t first) {
+  for (uint16_t n = 0; n < block->count; n++) {
+    const uint8_t *r = block->records + n * LPS2X_RECORD_SIZE;
+    int32_t pressure = r[0] | r[1] << 8 | r[2] << 16;
+    int16_t temp = (int16_t)(r[3] | r[4] << 8);
+    CHECK(pressure == press_of(first + n));
+    CHECK(temp == temp_of(first + n));
+  }
+}
+
+/** Samples on the period grid come back as one block, header intact */
+static void test_log_round_trip(void) {
+  std::vector<uint8_t> log;
+  write_log(&log, 1000, 10);
+  CHECK(log.size() == LPS2X_LOG_HEADER_SIZE + LPS2X_LOG_BLOCK_HEADER_SIZE +
+                          10 * LPS2X_RECORD_SIZE);
+
+  Adafruit_LPS2X_LogReader reader;
+  CHECK(reader.begin(log.data(), log.size()));
+  CHECK(reader.chipID() == LPS25HB_CHIP_ID);
+  CHECK(reader.tempScale() == LPS25_TEMP_SCALE);
+  CHECK(reader.tempOffset() == LPS25_TEMP_OFFSET);
+  CHECK(reader.period() == period_us);
+
+  lps2x_log_block_t block;
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.start == 1000);
+  CHECK(block.period == period_us);
+  CHECK(block.count == 10);
+  check_records(&block, 0);
+  CHECK(!reader.nextBlock(&block));
+}
+
+/** A sample off the grid starts a new block at its own time */
+static void test_log_gap_starts_block(void) {
+  std::vector<uint8_t> log;
+  Adafruit_LPS2X_LogWriter writer(to_vector, &log);
+  CHECK(writer.begin(LPS25HB_CHIP_ID, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET,
+                     period_us));
+  CHECK(writer.add(0, press_of(0), temp_of(0)));
+  CHECK(writer.add(period_us + period_us / 4, press_of(1), temp_of(1)));
+  CHECK(writer.add(5 * period_us, press_of(2), temp_of(2))); // missed three
+  CHECK(writer.flush());
+
+  Adafruit_LPS2X_LogReader reader;
+  CHECK(reader.begin(log.data(), log.size()));
+  lps2x_log_block_t block;
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.start == 0);
+  CHECK(block.count == 2); // within half a period is on time
+  check_records(&block, 0);
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.start == 5 * period_us);
+  CHECK(block.count == 1);
+  check_records(&block, 2);
+  CHECK(!reader.nextBlock(&block));
+}
+
+/** A block is written once it holds `LPS2X_LOG_BLOCK_RECORDS` records */
+static void test_log_block_fills(void) {
+  std::vector<uint8_t> log;
+  Adafruit_LPS2X_LogWriter writer(to_vector, &log);
+  CHECK(writer.begin(LPS25HB_CHIP_ID, LPS25_TEMP_SCALE, LPS25_TEMP_OFFSET,
+                     period_us));
+  for (uint32_t i = 0; i <= LPS2X_LOG_BLOCK_RECORDS; i++) {
+    CHECK(writer.add(i * period_us, press_of(i), temp_of(i)));
+  }
+  CHECK(log.size() == LPS2X_LOG_HEADER_SIZE + LPS2X_LOG_BLOCK_HEADER_SIZE +
+                          LPS2X_LOG_BLOCK_RECORDS * LPS2X_RECORD_SIZE);
+  CHECK(writer.flush());
+
+  Adafruit_LPS2X_LogReader reader;
+  CHECK(reader.begin(log.data(), log.size()));
+  lps2x_log_block_t block;
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.count == LPS2X_LOG_BLOCK_RECORDS);
+  check_records(&block, 0);
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.start == LPS2X_LOG_BLOCK_RECORDS * period_us);
+  CHECK(block.count == 1);
+  check_records(&block, LPS2X_LOG_BLOCK_RECORDS);
+  CHECK(!reader.nextBlock(&block));
+}
+
+/** A log cut off mid-record yields the complete records only */
+static void test_log_truncated_block(void) {
+  std::vector<uint8_t> log;
+  write_log(&log, 0, 10);
+  log.resize(log.size() - LPS2X_RECORD_SIZE - 2);
+
+  Adafruit_LPS2X_LogReader reader;
+  CHECK(reader.begin(log.data(), log.size()));
+  lps2x_log_block_t block;
+  CHECK(reader.nextBlock(&block));
+  CHECK(block.count == 8);
+  check_records(&block, 0);
+  CHECK(!reader.nextBlock(&block));
+
+  log.resize(LPS2X_LOG_HEADER_SIZE + LPS2X_LOG_BLOCK_HEADER_SIZE - 1);
+  CHECK(reader.begin(log.data(), log.size()));
+  CHECK(!reader.nextBlock(&block)); // block header cut short
+}
+
+/** Only logs with the right magic and version are read */
+static void test_log_rejects_bad_header(void) {
+  std::vector<uint8_t> log;
+  write_log(&log, 0, 1);
+  Adafruit_LPS2X_LogReader reader;
+
+  std::vector<uint8_t> bad = log;
+  bad[0] = 'X';
+  CHECK(!reader.begin(bad.data(), bad.size()));
+  bad = log;
+  bad[4] = LPS2X_LOG_VERSION + 1;
+  CHECK(!reader.begin(bad.data(), bad.size()));
+  CHECK(!reader.begin(log.data(), LPS2X_LOG_HEADER_SIZE - 1));
+  CHECK(reader.begin(log.data(), log.size()));
+}
+
+/** A failed write is reported, and the next block still goes out */
+static void test_log_write_failure(void) {
+  Adafruit_LPS2X_LogWriter writer(to_nowhere);
+  CHECK(!writer.begin(LPS22HB_CHIP_ID, LPS22_TEMP_SCALE, LPS22_TEMP_OFFSET,
+                      period_us));
+  CHECK(writer.add(0, press_of(0), temp_of(0))); // buffered
+  CHECK(!writer.flush());
+  CHECK(writer.flush()); // nothing left
+}
+
+/** The reader's records and scaling feed the batch decoder directly */
+static void test_log_decodes(void) {
+  std::vector<uint8_t> log;
+  write_log(&log, 0, 40);
+
+  Adafruit_LPS2X_LogReader reader;
+  CHECK(reader.begin(log.data(), log.size()));
+  lps2x_log_block_t block;
+  uint32_t first = 0;
+  while (reader.nextBlock(&block)) {
+    float pressure[LPS2X_LOG_BLOCK_RECORDS];
+    float temperature[LPS2X_LOG_BLOCK_RECORDS];
+    lps2x_decode_records(block.records, block.count, reader.tempScale(),
+                         reader.tempOffset(), pressure, temperature);
+    for (uint16_t n = 0; n < block.count; n++) {
+      CHECK_NEAR(pressure[n], press_of(first + n) / 4096.0, 1e-4);
+      CHECK_NEAR(temperature[n], temp_of(first + n) / 480.0 + 42.5, 1e-4);
+    }
+    first += block.count;
+  }
+  CHECK(first == 40);
+}
+
+int main(void) {
+  RUN(test_log_round_trip);
+  RUN(test_log_gap_starts_block);
+  RUN(test_log_block_fills);
+  RUN(test_log_truncated_block);
+  RUN(test_log_rejects_bad_header);
+  RUN(test_log_write_failure);
+  RUN(test_log_decodes);
+  return test_summary();
+}
@@ -0,0 +1,162 @@
+/*!
+ *  @file test_read.cpp
+ *
+ * 	Bus traffic and values of the driver's read paths, measured on the
+ * 	simulated chips
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "test_common.h"
+#include <Adafruit_LPS2X.h>
+
+/** Reading an event in continuous mode is one 5-byte burst on I2C */
+static void test_lps22_i2c_event_is_one_transaction(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.pressure = 987.5f;
+  sim.temperature = 21.25f;
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  sim.advance(40000);
+
+  sensors_event_t pressure, temp;
+  sim.resetCounters();
+  lps.resetBusStats();
+  CHECK(lps.getEvent(&pressure, &temp));
+
+  lps2x_bus_stats_t stats;
+  lps.getBusStats(&stats);
+  CHECK(sim.transactions == 1);
+  CHECK(sim.bytes == 3 + 5); // two address bytes, the register, the data
+  CHECK(stats.transactions == sim.transactions);
+  CHECK(stats.bytes == sim.bytes);
+  CHECK_NEAR(pressure.pressure, 987.5, 1.0 / 4096);
+  CHECK_NEAR(temp.temperature, 21.25, 0.01);
+}
+
+/** The LPS25 needs the SPI auto increment bit to burst read */
+static void test_lps25_spi_event_is_one_transaction(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachSPI(10);
+  sim.pressure = 1001.0f;
+  sim.temperature = -5.5f;
+
+  Adafruit_LPS25 lps;
+  CHECK(lps.begin_SPI(10));
+  sim.advance(40000);
+
+  sensors_event_t pressure, temp;
+  sim.resetCounters();
+  CHECK(lps.getEvent(&pressure, &temp));
+
+  CHECK(sim.transactions == 1);
+  CHECK(sim.bytes == 1 + 5);
+  CHECK_NEAR(pressure.pressure, 1001.0, 1.0 / 4096);
+  CHECK_NEAR(temp.temperature, -5.5, 1.0 / 480);
+}
+
+/** The LPS25 data interrupt sources are shadowed like the other controls */
+static void test_lps25_data_interrupt_is_shadowed(void) {
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.poke(LPS25_CTRL_REG4, 0x01); // data ready, left by an earlier run
+
+  Adafruit_LPS25 lps;
+  lps.setFastInit(true);
+  CHECK(lps.begin_I2C());
+  sim.resetCounters();
+  lps.configureDataInterrupt(true);
+  CHECK(sim.transactions == 0); // already set, not rewritten
+
+  lps.configureDataInterrupt(false, false, true);
+  CHECK(sim.transactions == 1);
+  CHECK(sim.peek(LPS25_CTRL_REG4) == 0x04);
+}
+
+/** With caching, a pressure-only sample is not served as a temperature */
+static void test_cached_temperature_is_fresh(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.temperature = 20.0f;
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setSampleCaching(true);
+  lps.setTemperatureDivider(4);
+  Adafruit_Sensor *pressure_sensor = lps.getPressureSensor();
+  Adafruit_Sensor *temp_sensor = lps.getTemperatureSensor();
+
+  sensors_event_t pressure, temp;
+  sim.advance(40000);
+  CHECK(pressure_sensor->getEvent(&pressure)); // full sample
+
+  sim.temperature = 30.0f;
+  sim.advance(40000);
+  sim.resetCounters();
+  CHECK(pressure_sensor->getEvent(&pressure)); // pressure only
+  CHECK(sim.bytes == 3 + 3);
+  CHECK(temp_sensor->getEvent(&temp)); // same period, must still read
+  CHECK(sim.transactions == 2);
+  CHECK_NEAR(temp.temperature, 30.0, 0.01);
+}
+
+/** The simulator follows the configured output data rate */
+static void test_sim_output_data_rate(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_75_HZ);
+  sim.resetCounters();
+  sim.advance(1000000);
+  CHECK(sim.conversions == 75);
+}
+
+/** Scripted waveforms come out of the FIFO in order and without gaps */
+static void test_sim_fifo_waveform(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  sim.waveform = [](uint64_t t, float *p, float *c) {
+    *p = 900 + (float)(t / 20000);
+    *c = 20;
+  };
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_50_HZ);
+  lps.setFifoMode(LPS22_FIFO_STREAM);
+  sim.advance(10 * 20000);
+  CHECK(lps.getFifoLevel() == 10);
+
+  lps2x_sample_t samples[LPS2X_FIFO_DEPTH];
+  uint8_t count = lps.readFifo(samples, LPS2X_FIFO_DEPTH);
+  CHECK(count == 10);
+  for (uint8_t i = 1; i < count; i++) {
+    CHECK_NEAR(samples[i].pressure - samples[i - 1].pressure, 1, 1e-3);
+  }
+  CHECK(lps.getFifoLevel() == 0);
+}
+
+/** A chip that NACKs is not found */
+static void test_sim_missing_chip(void) {
+  Adafruit_LPS22 lps;
+  CHECK(!lps.begin_I2C(0x5C));
+
+  LPS2XSim sim(LPS25HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  CHECK(!lps.begin_I2C()); // wrong WHOAMI
+}
+
+int main(void) {
+  RUN(test_lps22_i2c_event_is_one_transaction);
+  RUN(test_lps25_spi_event_is_one_transaction);
+  RUN(test_lps25_data_interrupt_is_shadowed);
+  RUN(test_cached_temperature_is_fresh);
+  RUN(test_sim_output_data_rate);
+  RUN(test_sim_fifo_waveform);
+  RUN(test_sim_missing_chip);
+  return test_summary();
+}
@@ -0,0 +1,154 @@
+/*!
+ *  @file test_ring.cpp
+ *
+ * 	The interrupt driven sample ring, with `handleInterrupt` and `service`
+ * 	on one thread standing in for the ISR and the consumer on another
+ *
+ *	BSD license (see license.txt)
+ */
+
+#include "lps2x_sim.h"
+#include "test_common.h"
+#include <Adafruit_LPS2X.h>
+#include <chrono>
+#include <thread>
+
+static const uint32_t period_us = 1000000 / 75; ///< LPS22 at 75 Hz
+
+/** Numbers conversions so each sample's pressure and temperature match */
+static void number_samples(LPS2XSim *sim) {
+  uint32_t n = 0;
+  sim->waveform = [n](uint64_t, float *p, float *c) mutable {
+    uint32_t k = n++ % 256;
+    *p = 900.0f + k;
+    *c = k / 4.0f;
+  };
+}
+
+/** Checks a sample is whole, returning its number within the waveform */
+static int32_t sample_number(const lps2x_raw_sample_t *sample) {
+  int32_t k = sample->pressure / 4096 - 900;
+  if (sample->pressure % 4096 || k < 0 || k > 255 ||
+      sample->temperature != k * 25) {
+    return -1; // torn between two conversions
+  }
+  return k;
+}
+
+/** Produces `count` samples on another thread, paced in real time when
+    `paced`, and consumes them here until the producer is done */
+static void run_threads(LPS2XSim *sim, Adafruit_LPS22 *lps, uint32_t count,
+                        bool paced, uint32_t *received, uint32_t *bad) {
+  sim->on_drdy = [lps](uint64_t) { lps->handleInterrupt(); };
+  bool done = false;
+  std::thread isr([&]() {
+    for (uint32_t i = 0; i < count; i++) {
+      if (paced) {
+        std::this_thread::sleep_for(std::chrono::microseconds(period_us));
+      }
+      sim->advance(period_us);
+      lps->service();
+    }
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  });
+
+  lps2x_raw_sample_t sample;
+  uint32_t last_time = 0;
+  *received = *bad = 0;
+  while (true) {
+    bool finished = __atomic_load_n(&done, __ATOMIC_ACQUIRE);
+    while (lps->readBufferedSample(&sample)) {
+      if (sample_number(&sample) < 0 ||
+          (*received && sample.timestamp <= last_time)) {
+        (*bad)++;
+      }
+      last_time = sample.timestamp;
+      (*received)++;
+    }
+    if (finished) {
+      break;
+    }
+    if (paced) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  isr.join();
+  sim->on_drdy = nullptr;
+}
+
+/** At 75 Hz every data ready sample reaches the consumer, whole */
+static void test_ring_75hz_threads(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  number_samples(&sim);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_75_HZ);
+  lps2x_raw_sample_t ring[16];
+  CHECK(lps.enableSampleBuffer(ring, 16));
+
+  uint32_t received, bad;
+  run_threads(&sim, &lps, 150, true, &received, &bad);
+  CHECK(received == 150);
+  CHECK(bad == 0);
+  CHECK(lps.samplesDropped() == 0);
+}
+
+/** Unpaced, a small ring overflows, but every sample is either delivered
+    whole or counted as dropped */
+static void test_ring_threads_account_for_every_sample(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  number_samples(&sim);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_75_HZ);
+  lps2x_raw_sample_t ring[4];
+  CHECK(lps.enableSampleBuffer(ring, 4));
+
+  uint32_t received, bad;
+  run_threads(&sim, &lps, 20000, false, &received, &bad);
+  CHECK(received + lps.samplesDropped() == 20000);
+  CHECK(bad == 0);
+}
+
+/** Two data ready interrupts before `service` count the overwritten sample */
+static void test_ring_counts_overrun(void) {
+  LPS2XSim sim(LPS22HB_CHIP_ID);
+  sim.attachI2C(LPS2X_I2CADDR_DEFAULT);
+  number_samples(&sim);
+
+  Adafruit_LPS22 lps;
+  CHECK(lps.begin_I2C());
+  lps.setDataRate(LPS22_RATE_75_HZ);
+  lps2x_raw_sample_t ring[8];
+  CHECK(lps.enableSampleBuffer(ring, 8));
+  sim.on_drdy = [&lps](uint64_t) { lps.handleInterrupt(); };
+
+  sim.advance(period_us);
+  CHECK(lps.service() == 1);
+  CHECK(lps.samplesDropped() == 0);
+
+  sim.advance(2 * period_us);
+  CHECK(lps.service() == 1);
+  CHECK(lps.samplesDropped() == 1);
+
+  lps2x_raw_sample_t sample;
+  CHECK(lps.readBufferedSample(&sample));
+  CHECK(sample_number(&sample) == 0);
+  CHECK(lps.readBufferedSample(&sample));
+  CHECK(sample_number(&sample) == 2); // the latest one
+  CHECK(!lps.readBufferedSample(&sample));
+  lps.handleInterrupt();
+  CHECK(lps.service() == 0); // spurious, nothing new
+  sim.on_drdy = nullptr;
+}
+
+int main(void) {
+  RUN(test_ring_75hz_threads);
+  RUN(test_ring_threads_account_for_every_sample);
+  RUN(test_ring_counts_overrun);
+  return test_summary();
+}